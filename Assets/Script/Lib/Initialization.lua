@@ -7,6 +7,7 @@ local App = builtin.Application()
 local Content = builtin.Content()
 local Director = builtin.Director()
 local View = builtin.View()
+local FrameProfiler = builtin.FrameProfiler()
 local Audio = builtin.Audio()
 local Keyboard = builtin.Keyboard()
 local AI = builtin.Platformer.AI()
@@ -16,6 +17,7 @@ builtin.App = App
 builtin.Content = Content
 builtin.Director = Director
 builtin.View = View
+builtin.FrameProfiler = FrameProfiler
 builtin.Audio = Audio
 builtin.Keyboard = Keyboard
 builtin.Platformer.AI = AI
@@ -136,6 +138,17 @@ builtin.threadLoop = function(routine)
 	return Routine(loop(routine))
 end
 
+builtin.profile = function(name, work)
+	FrameProfiler:push(name)
+	-- always pop the scope so an error does not leave it open
+	local success, result = pcall(work)
+	FrameProfiler:pop()
+	if not success then
+		error(result, 0)
+	end
+	return result
+end
+
 builtin.sleep = function(duration)
 	if duration then
 		local time = 0
@@ -8,6 +8,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include "Const/Header.h"
 #include "Animation/Action.h"
+#include "Animation/Tween.h"
+#include "Basic/Scheduler.h"
 #include "Node/Node.h"
 #include "Common/Utils.h"
 #include "Node/Sprite.h"
@@ -33,6 +35,7 @@ static void SetHeight(Node* target, float value) { target->setHeight(value); }
 static void SetAnchorX(Node* target, float value) { target->setAnchor(Vec2{value, target->getAnchor().y}); }
 static void SetAnchorY(Node* target, float value) { target->setAnchor(Vec2{target->getAnchor().x, value}); }
 static void SetOpacity(Node* target, float value) { target->setOpacity(value); }
+static void SetVisible(Node* target, float value) { target->setVisible(value != 0.0f); }
 
 static SetFunc setFuncs[] = {
 	SetNone,
@@ -50,7 +53,8 @@ static SetFunc setFuncs[] = {
 	SetHeight,
 	SetAnchorX,
 	SetAnchorY,
-	SetOpacity
+	SetOpacity,
+	SetVisible
 };
 
 SetFunc Property::getFunc(Property::Enum prop)
@@ -58,6 +62,43 @@ SetFunc Property::getFunc(Property::Enum prop)
 	return setFuncs[prop];
 }
 
+static const char* propNames[] = {
+	"None",
+	"X",
+	"Y",
+	"Z",
+	"Angle",
+	"AngleX",
+	"AngleY",
+	"ScaleX",
+	"ScaleY",
+	"SkewX",
+	"SkewY",
+	"Width",
+	"Height",
+	"AnchorX",
+	"AnchorY",
+	"Opacity",
+	"Visible"
+};
+
+Slice Property::getName(Property::Enum prop)
+{
+	return Slice(propNames[prop]);
+}
+
+Property::Enum Property::fromName(String name)
+{
+	for (int i = Property::X; i <= Property::Visible; i++)
+	{
+		if (name == Slice(propNames[i]))
+		{
+			return s_cast<Property::Enum>(i);
+		}
+	}
+	return Property::None;
+}
+
 static bx::EaseFn easeFuncs[] = {
 	bx::easeLinear,
 	bx::easeInQuad,
@@ -120,12 +161,35 @@ Own<ActionDuration> PropertyAction::alloc(float duration, float start, float sto
 	action->_start = start;
 	action->_delta = stop - start;
 	action->_duration = std::max(FLT_EPSILON, duration);
+	action->_prop = prop;
 	action->_setFunc = Property::getFunc(prop);
 	action->_ease = Ease::getFunc(easing);
+	action->_easing = easing;
 	action->_ended = false;
 	return Own<ActionDuration>(action);
 }
 
+Own<ActionDuration> PropertyAction::clone() const
+{
+	return Own<ActionDuration>(new PropertyAction(*this));
+}
+
+bool PropertyAction::flatten(Timeline* timeline, float offset) const
+{
+	timeline->addSegment(_prop, offset, _duration, _start, _start + _delta, _ease);
+	return true;
+}
+
+bool PropertyAction::isTweenable(float duration) const
+{
+	return _duration == duration;
+}
+
+void PropertyAction::tween(TweenBatch* batch, Node* target, Action* owner, float eclapsed) const
+{
+	batch->start(target, _prop, _duration, _start, _start + _delta, _easing, owner, eclapsed);
+}
+
 Action* PropertyAction::create(float duration, float start, float stop, Property::Enum prop, Ease::Enum easing)
 {
 	return Action::create(PropertyAction::alloc(duration, start, stop, prop, easing));
@@ -150,8 +214,8 @@ bool PropertyAction::update(Node* target, float eclapsed)
 Own<ActionDuration> Roll::alloc(float duration, float start, float stop, Ease::Enum easing)
 {
 	Roll* action = new Roll();
-	if (start > 0) start = std::fmodf(start, 360.0f);
-	else start = std::fmodf(start, -360.0f);
+	if (start > 0) start = std::fmod(start, 360.0f);
+	else start = std::fmod(start, -360.0f);
 	float delta = stop - start;
 	if (delta > 180) delta -= 360;
 	else if (delta < -180) delta += 360;
@@ -163,6 +227,17 @@ Own<ActionDuration> Roll::alloc(float duration, float start, float stop, Ease::E
 	return Own<ActionDuration>(action);
 }
 
+Own<ActionDuration> Roll::clone() const
+{
+	return Own<ActionDuration>(new Roll(*this));
+}
+
+bool Roll::flatten(Timeline* timeline, float offset) const
+{
+	timeline->addSegment(Property::Angle, offset, _duration, _start, _start + _delta, _ease);
+	return true;
+}
+
 Action* Roll::create(float duration, float start, float stop, Ease::Enum easing)
 {
 	return Action::create(Roll::alloc(duration, start, stop, easing));
@@ -246,6 +321,34 @@ Own<ActionDuration> Spawn::alloc(std::initializer_list<RRefCapture<Own<ActionDur
 	return first;
 }
 
+Own<ActionDuration> Spawn::clone() const
+{
+	Spawn* action = new Spawn();
+	action->_ended = _ended;
+	action->_duration = _duration;
+	if (_first) action->_first = _first->clone();
+	if (_second) action->_second = _second->clone();
+	return Own<ActionDuration>(action);
+}
+
+bool Spawn::flatten(Timeline* timeline, float offset) const
+{
+	return (!_first || _first->flatten(timeline, offset)) &&
+		(!_second || _second->flatten(timeline, offset));
+}
+
+bool Spawn::isTweenable(float duration) const
+{
+	return (!_first || _first->isTweenable(duration)) &&
+		(!_second || _second->isTweenable(duration));
+}
+
+void Spawn::tween(TweenBatch* batch, Node* target, Action* owner, float eclapsed) const
+{
+	if (_first) _first->tween(batch, target, owner, eclapsed);
+	if (_second) _second->tween(batch, target, owner, eclapsed);
+}
+
 Action* Spawn::create(Own<ActionDuration>&& first, Own<ActionDuration>&& second)
 {
 	return Action::create(Spawn::alloc(std::move(first), std::move(second)));
@@ -332,6 +435,23 @@ Own<ActionDuration> Sequence::alloc(std::initializer_list<RRefCapture<Own<Action
 	return first;
 }
 
+Own<ActionDuration> Sequence::clone() const
+{
+	Sequence* action = new Sequence();
+	action->_ended = _ended;
+	action->_duration = _duration;
+	if (_first) action->_first = _first->clone();
+	if (_second) action->_second = _second->clone();
+	return Own<ActionDuration>(action);
+}
+
+bool Sequence::flatten(Timeline* timeline, float offset) const
+{
+	float duration = _first ? _first->getDuration() : 0.0f;
+	return (!_first || _first->flatten(timeline, offset)) &&
+		(!_second || _second->flatten(timeline, offset + duration));
+}
+
 Action* Sequence::create(Own<ActionDuration>&& first, Own<ActionDuration>&& second)
 {
 	return Action::create(Sequence::alloc(std::move(first), std::move(second)));
@@ -367,6 +487,18 @@ Own<ActionDuration> Delay::alloc(float duration)
 	return Own<ActionDuration>(action);
 }
 
+Own<ActionDuration> Delay::clone() const
+{
+	return Own<ActionDuration>(new Delay(*this));
+}
+
+bool Delay::flatten(Timeline* timeline, float offset) const
+{
+	DORA_UNUSED_PARAM(timeline);
+	DORA_UNUSED_PARAM(offset);
+	return true;
+}
+
 Action* Delay::create(float duration)
 {
 	return Action::create(Delay::alloc(duration));
@@ -394,6 +526,17 @@ Own<ActionDuration> Show::alloc()
 	return Own<ActionDuration>(show);
 }
 
+Own<ActionDuration> Show::clone() const
+{
+	return Own<ActionDuration>(new Show(*this));
+}
+
+bool Show::flatten(Timeline* timeline, float offset) const
+{
+	timeline->addStep(Property::Visible, offset, 1.0f);
+	return true;
+}
+
 Action* Show::create()
 {
 	return Action::create(Show::alloc());
@@ -421,6 +564,17 @@ Own<ActionDuration> Hide::alloc()
 	return Own<ActionDuration>(hide);
 }
 
+Own<ActionDuration> Hide::clone() const
+{
+	return Own<ActionDuration>(new Hide(*this));
+}
+
+bool Hide::flatten(Timeline* timeline, float offset) const
+{
+	timeline->addStep(Property::Visible, offset, 0.0f);
+	return true;
+}
+
 Action* Hide::create()
 {
 	return Action::create(Hide::alloc());
@@ -438,7 +592,7 @@ float Emit::getDuration() const
 bool Emit::update(Node* target, float eclapsed)
 {
 	if (_ended && eclapsed > 0.0f) return true;
-	if (Emit::available) target->emit(_event);
+	if (Emit::available) target->emit(_eventId);
 	_ended = eclapsed > 0.0f;
 	return true;
 }
@@ -447,10 +601,15 @@ Own<ActionDuration> Emit::alloc(String event)
 {
 	Emit* emit = new Emit();
 	emit->_ended = false;
-	emit->_event = event;
+	emit->_eventId = Event::intern(event);
 	return Own<ActionDuration>(emit);
 }
 
+Own<ActionDuration> Emit::clone() const
+{
+	return Own<ActionDuration>(new Emit(*this));
+}
+
 Action* Emit::create(String event)
 {
 	return Action::create(Emit::alloc(event));
@@ -481,6 +640,11 @@ Own<ActionDuration> PlaySound::alloc(String filename)
 	return Own<ActionDuration>(play);
 }
 
+Own<ActionDuration> PlaySound::clone() const
+{
+	return Own<ActionDuration>(new PlaySound(*this));
+}
+
 Action* PlaySound::create(String filename)
 {
 	return Action::create(PlaySound::alloc(filename));
@@ -527,11 +691,136 @@ Own<ActionDuration> FrameAction::alloc(FrameActionDef* def)
 	return Own<ActionDuration>(action);
 }
 
+Own<ActionDuration> FrameAction::clone() const
+{
+	return Own<ActionDuration>(new FrameAction(*this));
+}
+
 Action* FrameAction::create(FrameActionDef* def)
 {
 	return Action::create(FrameAction::alloc(def));
 }
 
+/* Timeline */
+
+const Uint32 Timeline::None = UINT32_MAX;
+
+Timeline::Timeline():
+_duration(0.0f),
+_eclapsed(0.0f)
+{ }
+
+float Timeline::getDuration() const
+{
+	return _duration;
+}
+
+Timeline::Track& Timeline::getTrack(Property::Enum prop)
+{
+	for (Track& track : _tracks)
+	{
+		if (track.prop == prop)
+		{
+			return track;
+		}
+	}
+	_tracks.push_back({prop, Property::getFunc(prop), None, false, {}});
+	return _tracks.back();
+}
+
+void Timeline::addSegment(Property::Enum prop, float time, float duration, float start, float stop, bx::EaseFn ease)
+{
+	getTrack(prop).segments.push_back({time, duration, start, stop - start, ease});
+}
+
+void Timeline::addStep(Property::Enum prop, float time, float value)
+{
+	getTrack(prop).segments.push_back({time, 0.0f, value, 0.0f, nullptr});
+}
+
+Uint32 Timeline::seek(const Track& track, float time)
+{
+	const auto& segments = track.segments;
+	Uint32 count = s_cast<Uint32>(segments.size());
+	if (track.cursor != None)
+	{
+		/* playing mostly stays in the current segment or moves to the next one */
+		for (Uint32 i = track.cursor; i < count && i <= track.cursor + 1; i++)
+		{
+			if (segments[i].time <= time && (i + 1 == count || time < segments[i + 1].time))
+			{
+				return i;
+			}
+		}
+	}
+	auto it = std::upper_bound(segments.begin(), segments.end(), time, [](float time, const Segment& segment)
+	{
+		return time < segment.time;
+	});
+	return it == segments.begin() ? None : s_cast<Uint32>(it - segments.begin()) - 1;
+}
+
+bool Timeline::update(Node* target, float eclapsed)
+{
+	bool rewind = eclapsed <= 0.0f || eclapsed < _eclapsed;
+	_eclapsed = eclapsed;
+	for (Track& track : _tracks)
+	{
+		Uint32 index = seek(track, eclapsed);
+		if (index == None)
+		{
+			track.cursor = None;
+			track.settled = false;
+			continue;
+		}
+		const Segment& segment = track.segments[index];
+		float time = segment.duration > 0.0f ? (eclapsed - segment.time) / segment.duration : 1.0f;
+		bool settled = time >= 1.0f;
+		if (settled && track.settled && track.cursor == index && !rewind)
+		{
+			continue;
+		}
+		track.cursor = index;
+		track.settled = settled;
+		track.setFunc(target, segment.start + segment.delta * (settled ? 1.0f : segment.ease(std::max(time, 0.0f))));
+	}
+	return eclapsed >= _duration;
+}
+
+Own<ActionDuration> Timeline::clone() const
+{
+	return Own<ActionDuration>(new Timeline(*this));
+}
+
+Own<ActionDuration> Timeline::compile(const ActionDuration* action)
+{
+	if (!action) return Own<ActionDuration>();
+	Timeline* timeline = new Timeline();
+	Own<ActionDuration> result(timeline);
+	if (!action->flatten(timeline, 0.0f))
+	{
+		return Own<ActionDuration>();
+	}
+	timeline->_duration = action->getDuration();
+	for (Track& track : timeline->_tracks)
+	{
+		auto& segments = track.segments;
+		std::stable_sort(segments.begin(), segments.end(), [](const Segment& a, const Segment& b)
+		{
+			return a.time < b.time;
+		});
+		for (size_t i = 1; i < segments.size(); i++)
+		{
+			const Segment& last = segments[i - 1];
+			if (last.time + last.duration - segments[i].time > 1e-4f)
+			{
+				return Own<ActionDuration>();
+			}
+		}
+	}
+	return result;
+}
+
 /* Action */
 
 const int Action::InvalidOrder = -1;
@@ -543,11 +832,13 @@ _eclapsed(0),
 _target(nullptr),
 _action(std::move(actionDuration)),
 _reversed(false),
-_paused(false)
+_paused(false),
+_tweened(false)
 { }
 
 void Action::updateTo(float eclapsed, bool reversed)
 {
+	untween();
 	float oldEclapsed = _eclapsed;
 	bool oldReversed = _reversed;
 	_eclapsed = eclapsed;
@@ -582,6 +873,7 @@ bool Action::isRunning() const
 
 void Action::setReversed(bool var)
 {
+	if (var) untween();
 	_reversed = var;
 }
 
@@ -592,6 +884,7 @@ bool Action::isReversed() const
 
 void Action::setSpeed(float var)
 {
+	if (var != 1.0f) untween();
 	_speed = var;
 }
 
@@ -607,9 +900,19 @@ Own<ActionDuration>& Action::getAction()
 
 void Action::pause()
 {
+	untween();
 	_paused = true;
 }
 
+void Action::untween()
+{
+	if (_tweened)
+	{
+		_tweened = false;
+		if (_target) _target->getScheduler()->getTweens()->stop(_target, this);
+	}
+}
+
 void Action::resume()
 {
 	_paused = false;
@@ -36,9 +36,13 @@ struct Property
 		Height,
 		AnchorX,
 		AnchorY,
-		Opacity
+		Opacity,
+		Visible
 	};
 	static SetFunc getFunc(Property::Enum attr);
+	static Slice getName(Property::Enum attr);
+	/** @brief get the property by its enum name like "ScaleX", returns Property::None for unknown names. */
+	static Property::Enum fromName(String name);
 };
 
 struct Ease
@@ -91,22 +95,38 @@ struct Ease
 	static float func(Ease::Enum easing, float time);
 };
 
+class Timeline;
+class TweenBatch;
+class Action;
+
 class ActionDuration
 {
 public:
 	virtual ~ActionDuration() { }
 	virtual float getDuration() const = 0;
 	virtual bool update(Node* target, float eclapsed) = 0;
+	/** @brief copy the action definition together with its current progress. */
+	virtual Own<ActionDuration> clone() const = 0;
+	/** @brief add the segments of this action starting at offset to the timeline,
+	 returns false when the action can not be flattened. */
+	virtual bool flatten(Timeline* timeline, float offset) const { return false; }
+	/** @brief check that the action only tweens properties over the whole duration,
+	 so that it can be stepped by a tween batch. */
+	virtual bool isTweenable(float duration) const { return false; }
+	/** @brief start the property tweens of the action in the batch owned by the action. */
+	virtual void tween(TweenBatch* batch, Node* target, Action* owner, float eclapsed) const { }
 	DORA_TYPE_BASE(ActionDuration);
 };
 
-class Action;
-
 class PropertyAction : public ActionDuration
 {
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
+	virtual bool flatten(Timeline* timeline, float offset) const override;
+	virtual bool isTweenable(float duration) const override;
+	virtual void tween(TweenBatch* batch, Node* target, Action* owner, float eclapsed) const override;
 	static Own<ActionDuration> alloc(float duration, float start, float stop,
 		Property::Enum prop, Ease::Enum easing = Ease::Linear);
 	static Action* create(float duration, float start, float stop,
@@ -119,6 +139,8 @@ private:
 	float _delta;
 	float _duration;
 	bx::EaseFn _ease;
+	Ease::Enum _easing;
+	Property::Enum _prop;
 	SetFunc _setFunc;
 };
 
@@ -127,6 +149,8 @@ class Roll : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
+	virtual bool flatten(Timeline* timeline, float offset) const override;
 	static Own<ActionDuration> alloc(float duration, float start, float stop, Ease::Enum easing = Ease::Linear);
 	static Action* create(float duration, float start, float stop, Ease::Enum easing = Ease::Linear);
 protected:
@@ -144,6 +168,10 @@ class Spawn : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
+	virtual bool flatten(Timeline* timeline, float offset) const override;
+	virtual bool isTweenable(float duration) const override;
+	virtual void tween(TweenBatch* batch, Node* target, Action* owner, float eclapsed) const override;
 	static Own<ActionDuration> alloc(Own<ActionDuration>&& first, Own<ActionDuration>&& second);
 	static Own<ActionDuration> alloc(std::initializer_list<RRefCapture<Own<ActionDuration>>> actions);
 	static Own<ActionDuration> alloc(const vector<Own<ActionDuration>>& actions);
@@ -164,6 +192,8 @@ class Sequence : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
+	virtual bool flatten(Timeline* timeline, float offset) const override;
 	static Own<ActionDuration> alloc(Own<ActionDuration>&& first, Own<ActionDuration>&& second);
 	static Own<ActionDuration> alloc(std::initializer_list<RRefCapture<Own<ActionDuration>>> actions);
 	static Own<ActionDuration> alloc(vector<Own<ActionDuration>>&& actions);
@@ -184,6 +214,8 @@ class Delay : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
+	virtual bool flatten(Timeline* timeline, float offset) const override;
 	static Own<ActionDuration> alloc(float duration);
 	static Action* create(float duration);
 protected:
@@ -197,6 +229,8 @@ class Show : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
+	virtual bool flatten(Timeline* timeline, float offset) const override;
 	static Own<ActionDuration> alloc();
 	static Action* create();
 protected:
@@ -210,6 +244,8 @@ class Hide : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
+	virtual bool flatten(Timeline* timeline, float offset) const override;
 	static Own<ActionDuration> alloc();
 	static Action* create();
 protected:
@@ -223,6 +259,7 @@ class Emit : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
 	static Own<ActionDuration> alloc(String event);
 	static Action* create(String event);
 	static bool available;
@@ -230,7 +267,7 @@ protected:
 	Emit() { }
 private:
 	bool _ended;
-	string _event;
+	Uint32 _eventId;
 };
 
 class PlaySound : public ActionDuration
@@ -238,6 +275,7 @@ class PlaySound : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
 	static Own<ActionDuration> alloc(String filename);
 	static Action* create(String filename);
 	static bool available;
@@ -256,6 +294,7 @@ class FrameAction : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
 	static Own<ActionDuration> alloc(FrameActionDef* def);
 	static Action* create(FrameActionDef* def);
 protected:
@@ -266,6 +305,50 @@ private:
 	Ref<FrameActionDef> _def;
 };
 
+/** @brief Spawn and Sequence trees flattened into one track of segments per
+ property sorted by start time, so that seeking is independent of the tree
+ depth. A track keeps a cursor to its current segment that is reused when
+ playing moves within it or into the next segment, other seeks fall back
+ to a binary search. Settled segments are not applied again until the
+ timeline is rewound. */
+class Timeline : public ActionDuration
+{
+public:
+	virtual float getDuration() const override;
+	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
+	void addSegment(Property::Enum prop, float time, float duration, float start, float stop, bx::EaseFn ease);
+	void addStep(Property::Enum prop, float time, float value);
+	/** @brief returns an empty pointer when the tree contains actions that can not
+	 be flattened or tweens the same property with overlapping segments. */
+	static Own<ActionDuration> compile(const ActionDuration* action);
+protected:
+	Timeline();
+private:
+	struct Segment
+	{
+		float time;
+		float duration;
+		float start;
+		float delta;
+		bx::EaseFn ease;
+	};
+	struct Track
+	{
+		Property::Enum prop;
+		SetFunc setFunc;
+		Uint32 cursor;
+		bool settled;
+		vector<Segment> segments;
+	};
+	Track& getTrack(Property::Enum prop);
+	static Uint32 seek(const Track& track, float time);
+	static const Uint32 None;
+	float _duration;
+	float _eclapsed;
+	vector<Track> _tracks;
+};
+
 struct Move
 {
 	static inline Own<ActionDuration> alloc(float duration, const Vec2& startPos, const Vec2& endPos, Ease::Enum ease)
@@ -322,10 +405,13 @@ protected:
 	Action(Own<ActionDuration>&& actionDuration);
 private:
 	bool updateProgress();
+	/** @brief hand the property updates back from the tween batch to the action tree. */
+	void untween();
 	Ref<Action> _prev;
 	Ref<Action> _next;
 	bool _paused;
 	bool _reversed;
+	bool _tweened;
 	int _order;
 	float _speed;
 	float _eclapsed;
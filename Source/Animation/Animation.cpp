@@ -134,6 +134,25 @@ Own<ActionDuration> KeyReset::alloc(KeyFrameDef* def)
 	return Own<ActionDuration>(action);
 }
 
+Own<ActionDuration> KeyReset::clone() const
+{
+	return Own<ActionDuration>(new KeyReset(*this));
+}
+
+bool KeyReset::flatten(Timeline* timeline, float offset) const
+{
+	timeline->addStep(Property::X, offset, _x);
+	timeline->addStep(Property::Y, offset, _y);
+	timeline->addStep(Property::ScaleX, offset, _scaleX);
+	timeline->addStep(Property::ScaleY, offset, _scaleY);
+	timeline->addStep(Property::SkewX, offset, _skewX);
+	timeline->addStep(Property::SkewY, offset, _skewY);
+	timeline->addStep(Property::Angle, offset, _rotation);
+	if (!_visible) timeline->addStep(Property::Visible, offset, 0.0f);
+	timeline->addStep(Property::Opacity, offset, _opacity);
+	return true;
+}
+
 Action* KeyReset::create(KeyFrameDef* def)
 {
 	return Action::create(KeyReset::alloc(def));
@@ -272,6 +291,11 @@ Own<ActionDuration> ResetAction::alloc(float duration, SpriteDef* def, Ease::Enu
 	return Own<ActionDuration>(action);
 }
 
+Own<ActionDuration> ResetAction::clone() const
+{
+	return Own<ActionDuration>(new ResetAction(*this));
+}
+
 Action* ResetAction::create(float duration, SpriteDef* def, Ease::Enum easing)
 {
 	return Action::create(ResetAction::alloc(duration, def, easing));
@@ -369,7 +393,10 @@ Action* KeyAnimationDef::toAction()
 		keyAttrs.clear();
 		lastDef = def;
 	}
-	return Sequence::create(std::move(keyFrames));
+	/* prefer the flattened timeline for constant cost seeking */
+	Own<ActionDuration> sequence = Sequence::alloc(std::move(keyFrames));
+	Own<ActionDuration> timeline = Timeline::compile(sequence.get());
+	return Action::create(timeline ? std::move(timeline) : std::move(sequence));
 }
 
 string KeyAnimationDef::toXml()
@@ -56,6 +56,8 @@ class KeyReset : public ActionDuration
 public:
 	virtual float getDuration() const override;
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
+	virtual bool flatten(Timeline* timeline, float offset) const override;
 	static Own<ActionDuration> alloc(KeyFrameDef* def);
 	static Action* create(KeyFrameDef* def);
 private:
@@ -81,6 +83,7 @@ public:
 	void updateEndValues(KeyFrameDef* def);
 	void updateEndValues(SpriteDef* def);
 	virtual bool update(Node* target, float eclapsed) override;
+	virtual Own<ActionDuration> clone() const override;
 	static Own<ActionDuration> alloc(float duration, SpriteDef* def, Ease::Enum easing);
 	static Action* create(float duration, SpriteDef* def, Ease::Enum easing);
 private:
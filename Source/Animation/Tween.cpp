@@ -0,0 +1,254 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "Const/Header.h"
+#include "Animation/Tween.h"
+#include "Node/Node.h"
+#include "bx/simd_t.h"
+
+NS_DOROTHY_BEGIN
+
+static Uint32 tweenEndEvent()
+{
+	static const Uint32 eventId = Event::intern("TweenEnd"_slice);
+	return eventId;
+}
+
+static void applyTween(Node* target, Uint8 prop, float value)
+{
+	switch (prop)
+	{
+		case Property::X: target->setX(value); break;
+		case Property::Y: target->setY(value); break;
+		case Property::Z: target->setZ(value); break;
+		case Property::Angle: target->setAngle(value); break;
+		case Property::AngleX: target->setAngleX(value); break;
+		case Property::AngleY: target->setAngleY(value); break;
+		case Property::ScaleX: target->setScaleX(value); break;
+		case Property::ScaleY: target->setScaleY(value); break;
+		case Property::SkewX: target->setSkewX(value); break;
+		case Property::SkewY: target->setSkewY(value); break;
+		case Property::Width: target->setWidth(value); break;
+		case Property::Height: target->setHeight(value); break;
+		case Property::AnchorX: target->setAnchor(Vec2{value, target->getAnchor().y}); break;
+		case Property::AnchorY: target->setAnchor(Vec2{target->getAnchor().x, value}); break;
+		case Property::Opacity: target->setOpacity(value); break;
+		case Property::Visible: target->setVisible(value != 0.0f); break;
+		default: break;
+	}
+}
+
+TweenBatch::TweenBatch():
+_count(0)
+{ }
+
+Uint32 TweenBatch::getCount() const
+{
+	return _count;
+}
+
+Uint32 TweenBatch::find(Node* target, Property::Enum prop) const
+{
+	auto it = _indices.find({target, s_cast<Uint8>(prop)});
+	return it == _indices.end() ? _count : it->second;
+}
+
+void TweenBatch::start(Node* target, Property::Enum prop, float duration, float start, float stop, Ease::Enum easing,
+	Action* owner, float eclapsed)
+{
+	AssertIf(target == nullptr, "start tween on an invalid target.");
+	if (prop == Property::None) return;
+	Uint32 index = target->_tweenCount > 0 ? find(target, prop) : _count;
+	if (index == _count)
+	{
+		_count++;
+		size_t lanes = (_count + 3) / 4;
+		if (_starts.size() < lanes)
+		{
+			_starts.resize(lanes, Lane{});
+			_deltas.resize(lanes, Lane{});
+			_invDurations.resize(lanes, Lane{});
+			_eclapsed.resize(lanes, Lane{});
+			_steps.resize(lanes, Lane{});
+			_values.resize(lanes, Lane{});
+		}
+		_indices[{target, s_cast<Uint8>(prop)}] = index;
+		_targets.push_back(MakeRef(target));
+		_owners.push_back(owner);
+		_props.push_back(s_cast<Uint8>(prop));
+		_eases.push_back(s_cast<Uint8>(easing));
+		target->_tweenCount++;
+	}
+	else
+	{
+		_owners[index] = owner;
+		_eases[index] = s_cast<Uint8>(easing);
+	}
+	at(_starts, index) = start;
+	at(_deltas, index) = stop - start;
+	at(_invDurations, index) = 1.0f / std::max(FLT_EPSILON, duration);
+	at(_eclapsed, index) = eclapsed;
+}
+
+void TweenBatch::removeAt(Uint32 index)
+{
+	_targets[index]->_tweenCount--;
+	_indices.erase({_targets[index].get(), _props[index]});
+	Uint32 last = _count - 1;
+	if (index != last)
+	{
+		_indices[{_targets[last].get(), _props[last]}] = index;
+		_targets[index] = std::move(_targets[last]);
+		_owners[index] = _owners[last];
+		_props[index] = _props[last];
+		_eases[index] = _eases[last];
+		at(_starts, index) = at(_starts, last);
+		at(_deltas, index) = at(_deltas, last);
+		at(_invDurations, index) = at(_invDurations, last);
+		at(_eclapsed, index) = at(_eclapsed, last);
+	}
+	_targets.pop_back();
+	_owners.pop_back();
+	_props.pop_back();
+	_eases.pop_back();
+	_count--;
+}
+
+bool TweenBatch::stop(Node* target, Property::Enum prop)
+{
+	if (!target || target->_tweenCount == 0) return false;
+	Uint32 index = find(target, prop);
+	if (index == _count) return false;
+	removeAt(index);
+	return true;
+}
+
+void TweenBatch::stop(Node* target)
+{
+	for (int prop = Property::X; prop <= Property::Visible && target->_tweenCount > 0; prop++)
+	{
+		stop(target, s_cast<Property::Enum>(prop));
+	}
+}
+
+void TweenBatch::stop(Node* target, Action* owner)
+{
+	for (int prop = Property::X; prop <= Property::Visible && target->_tweenCount > 0; prop++)
+	{
+		Uint32 index = find(target, s_cast<Property::Enum>(prop));
+		if (index != _count && _owners[index] == owner)
+		{
+			removeAt(index);
+		}
+	}
+}
+
+void TweenBatch::transfer(Node* target, TweenBatch* batch)
+{
+	if (batch == this) return;
+	for (int prop = Property::X; prop <= Property::Visible && target->_tweenCount > 0; prop++)
+	{
+		Uint32 index = find(target, s_cast<Property::Enum>(prop));
+		if (index == _count) continue;
+		float start = at(_starts, index);
+		float duration = 1.0f / at(_invDurations, index);
+		batch->start(target, s_cast<Property::Enum>(prop), duration, start, start + at(_deltas, index),
+			s_cast<Ease::Enum>(_eases[index]), _owners[index], at(_eclapsed, index));
+		removeAt(index);
+	}
+}
+
+void TweenBatch::update(float deltaTime)
+{
+	if (_count == 0) return;
+	Uint32 lanes = (_count + 3) / 4;
+
+	/* culled nodes may opt out of stepping their tweens */
+	for (Uint32 i = 0; i < _count; i++)
+	{
+		Node* target = _targets[i].get();
+		at(_steps, i) = target->isPauseWhenCulled() && target->isCulled() ? 0.0f : deltaTime;
+	}
+
+	/* advance and normalize the time of four tweens at once */
+	const bx::simd128_t one = bx::simd_splat<bx::simd128_t>(1.0f);
+	for (Uint32 i = 0; i < lanes; i++)
+	{
+		bx::simd128_t eclapsed = bx::simd_add(
+			bx::simd_ld<bx::simd128_t>(&_eclapsed[i]),
+			bx::simd_ld<bx::simd128_t>(&_steps[i]));
+		bx::simd_st(&_eclapsed[i], eclapsed);
+		bx::simd_st(&_values[i], bx::simd_min(
+			bx::simd_mul(eclapsed, bx::simd_ld<bx::simd128_t>(&_invDurations[i])), one));
+	}
+
+	_ended.clear();
+	for (Uint32 i = 0; i < _count; i++)
+	{
+		float& time = at(_values, i);
+		if (time >= 1.0f)
+		{
+			time = 1.0f;
+			_ended.push_back(i);
+		}
+		else if (_eases[i] != Ease::Linear)
+		{
+			time = Ease::func(s_cast<Ease::Enum>(_eases[i]), time);
+		}
+	}
+
+	/* interpolate four values at once */
+	for (Uint32 i = 0; i < lanes; i++)
+	{
+		bx::simd_st(&_values[i], bx::simd_madd(
+			bx::simd_ld<bx::simd128_t>(&_values[i]),
+			bx::simd_ld<bx::simd128_t>(&_deltas[i]),
+			bx::simd_ld<bx::simd128_t>(&_starts[i])));
+	}
+
+	for (Uint32 i = 0; i < _count; i++)
+	{
+		if (at(_steps, i) > 0.0f || deltaTime == 0.0f)
+		{
+			applyTween(_targets[i].get(), _props[i], at(_values, i));
+		}
+	}
+
+	if (_ended.empty()) return;
+	vector<std::pair<Ref<Node>, Property::Enum>> ended;
+	ended.reserve(_ended.size());
+	for (auto it = _ended.rbegin(); it != _ended.rend(); ++it)
+	{
+		/* tweens of actions end with the ActionEnd event instead */
+		if (!_owners[*it])
+		{
+			ended.emplace_back(_targets[*it], s_cast<Property::Enum>(_props[*it]));
+		}
+		removeAt(*it);
+	}
+	for (const auto& item : ended)
+	{
+		item.first->emit(tweenEndEvent(), Property::getName(item.second), item.first.get());
+	}
+}
+
+void TweenBatch::clear()
+{
+	for (Uint32 i = 0; i < _count; i++)
+	{
+		_targets[i]->_tweenCount--;
+	}
+	_targets.clear();
+	_owners.clear();
+	_props.clear();
+	_eases.clear();
+	_indices.clear();
+	_count = 0;
+}
+
+NS_DOROTHY_END
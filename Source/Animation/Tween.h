@@ -0,0 +1,81 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include "Animation/Action.h"
+
+NS_DOROTHY_BEGIN
+
+class Node;
+
+/** @brief Property tweens of a scheduler kept in structure of arrays channels.
+ The timing and the interpolation are evaluated four tweens at a time with
+ SIMD, only the easing is done per tween, and the results are written back
+ to the nodes with direct setter calls. A node runs at most one tween for
+ each property, starting another one on the same property replaces it.
+ Tweens are indexed by node and property for lookups. Plain property actions
+ are stepped here too, their tweens are owned by the action and end silently. */
+class TweenBatch
+{
+public:
+	TweenBatch();
+	PROPERTY_READONLY(Uint32, Count);
+	void start(Node* target, Property::Enum prop, float duration, float start, float stop, Ease::Enum easing = Ease::Linear,
+		Action* owner = nullptr, float eclapsed = 0.0f);
+	bool stop(Node* target, Property::Enum prop);
+	void stop(Node* target);
+	/** @brief stop the tweens of the target started by the action. */
+	void stop(Node* target, Action* owner);
+	/** @brief move the tweens of the target to another batch with their progress kept. */
+	void transfer(Node* target, TweenBatch* batch);
+	void update(float deltaTime);
+	void clear();
+private:
+	struct alignas(16) Lane
+	{
+		float value[4];
+	};
+	static inline float& at(vector<Lane>& lanes, Uint32 index)
+	{
+		return lanes[index >> 2].value[index & 3];
+	}
+	struct Key
+	{
+		Node* target;
+		Uint8 prop;
+		bool operator==(const Key& other) const
+		{
+			return target == other.target && prop == other.prop;
+		}
+	};
+	struct KeyHash
+	{
+		size_t operator()(const Key& key) const
+		{
+			return std::hash<Node*>()(key.target) ^ (s_cast<size_t>(key.prop) * 0x9e3779b9u);
+		}
+	};
+	Uint32 find(Node* target, Property::Enum prop) const;
+	void removeAt(Uint32 index);
+	Uint32 _count;
+	vector<Ref<Node>> _targets;
+	vector<Action*> _owners; // weak reference
+	vector<Uint8> _props;
+	vector<Uint8> _eases;
+	vector<Lane> _starts;
+	vector<Lane> _deltas;
+	vector<Lane> _invDurations;
+	vector<Lane> _eclapsed;
+	vector<Lane> _steps;
+	vector<Lane> _values;
+	vector<Uint32> _ended;
+	unordered_map<Key, Uint32, KeyHash> _indices;
+};
+
+NS_DOROTHY_END
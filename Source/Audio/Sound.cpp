@@ -76,7 +76,10 @@ Audio::~Audio()
 
 bool Audio::init()
 {
-	SoLoud::result result = _soloud.init();
+	// use null audio driver in headless mode where no audio device is guaranteed
+	SoLoud::result result = SharedApplication.isHeadless() ?
+		_soloud.init(SoLoud::Soloud::CLIP_ROUNDOFF, SoLoud::Soloud::NULLDRIVER) :
+		_soloud.init();
 	if (result)
 	{
 		Error("fail to init soloud engine deal to reason: {}.", _soloud.getErrorString(result));
@@ -12,7 +12,9 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Basic/Director.h"
 #include "Basic/View.h"
 #include "Basic/Scheduler.h"
+#include "Basic/FrameProfiler.h"
 #include "bx/timer.h"
+#include "bx/commandline.h"
 #include <ctime>
 #include "Other/utf8.h"
 
@@ -45,7 +47,15 @@ NS_DOROTHY_BEGIN
 
 bool BGFXDora::init()
 {
-	return bgfx::init();
+	bgfx::Init init;
+	if (SharedApplication.isHeadless())
+	{
+		Size bufferSize = SharedApplication.getBufferSize();
+		init.type = bgfx::RendererType::Noop;
+		init.resolution.width = s_cast<Uint32>(bufferSize.width);
+		init.resolution.height = s_cast<Uint32>(bufferSize.height);
+	}
+	return bgfx::init(init);
 }
 
 BGFXDora::~BGFXDora()
@@ -54,21 +64,25 @@ BGFXDora::~BGFXDora()
 }
 
 Application::Application():
-_seed(0),
 _fpsLimited(false),
-_frame(0),
+_headless(false),
 _visualWidth(1024),
 _visualHeight(768),
 _winWidth(_visualWidth),
 _winHeight(_visualHeight),
 _bufferWidth(0),
 _bufferHeight(0),
+_seed(0),
 _maxFPS(60),
 _minFPS(30),
+_frame(0),
+_frequency(double(bx::getHPFrequency())),
 _deltaTime(0),
 _cpuTime(0),
+_frameJitter(0),
+_sleepCost(0.002),
 _totalTime(0),
-_frequency(double(bx::getHPFrequency())),
+_fixedFrameTime(0),
 _sdlWindow(nullptr)
 {
 	_lastTime = bx::getHPCounter() / _frequency;
@@ -150,6 +164,27 @@ bool Application::isFPSLimited() const
 	return _fpsLimited;
 }
 
+void Application::setHeadless(bool var)
+{
+	AssertIf(_logicThread.isRunning(), "headless mode should be set before application runs.");
+	_headless = var;
+}
+
+bool Application::isHeadless() const
+{
+	return _headless;
+}
+
+void Application::setFixedFrameTime(double var)
+{
+	_fixedFrameTime = std::max(var, 0.0);
+}
+
+double Application::getFixedFrameTime() const
+{
+	return _fixedFrameTime;
+}
+
 Uint32 Application::getFrame() const
 {
 	return _frame;
@@ -160,35 +195,60 @@ SDL_Window* Application::getSDLWindow() const
 	return _sdlWindow;
 }
 
+int Application::run(int argc, const char* const argv[])
+{
+	bx::CommandLine commandLine(argc, argv);
+	if (commandLine.hasArg("headless"))
+	{
+		Application::setHeadless(true);
+	}
+	double frameTime = 0.0;
+	if (commandLine.hasArg(frameTime, '\0', "frame-time"))
+	{
+		Application::setFixedFrameTime(frameTime);
+	}
+	return Application::run();
+}
+
 // This function runs in main thread, and do render work
 int Application::run()
 {
 	Application::setSeed(s_cast<Uint32>(std::time(nullptr)));
 
-	if (SDL_Init(SDL_INIT_GAMECONTROLLER|SDL_INIT_TIMER) != 0)
+	Uint32 initFlags = _headless ? SDL_INIT_EVENTS|SDL_INIT_TIMER : SDL_INIT_GAMECONTROLLER|SDL_INIT_TIMER;
+	if (SDL_Init(initFlags) != 0)
 	{
 		Error("SDL failed to initialize! {}", SDL_GetError());
 		return 1;
 	}
 
-	Uint32 windowFlags = SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_INPUT_FOCUS | SDL_WINDOW_RESIZABLE;
+	if (_headless)
+	{
+		// no window is created, bgfx will run with Noop renderer
+		_winWidth = _bufferWidth = _visualWidth;
+		_winHeight = _bufferHeight = _visualHeight;
+	}
+	else
+	{
+		Uint32 windowFlags = SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_INPUT_FOCUS | SDL_WINDOW_RESIZABLE;
 #if BX_PLATFORM_WINDOWS
-	windowFlags |= SDL_WINDOW_HIDDEN;
+		windowFlags |= SDL_WINDOW_HIDDEN;
 #elif BX_PLATFORM_IOS || BX_PLATFORM_ANDROID
-	windowFlags |= SDL_WINDOW_FULLSCREEN;
+		windowFlags |= SDL_WINDOW_FULLSCREEN;
 #endif
-	_sdlWindow = SDL_CreateWindow("Dorothy SSR",
-		SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-		_winWidth, _winHeight, windowFlags);
-	if (!_sdlWindow)
-	{
-		Error("SDL failed to create window!");
-		return 1;
-	}
-	Application::setupSdlWindow();
+		_sdlWindow = SDL_CreateWindow("Dorothy SSR",
+			SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
+			_winWidth, _winHeight, windowFlags);
+		if (!_sdlWindow)
+		{
+			Error("SDL failed to create window!");
+			return 1;
+		}
+		Application::setupSdlWindow();
 #if BX_PLATFORM_OSX
-	SDL_HideWindow(_sdlWindow);
+		SDL_HideWindow(_sdlWindow);
 #endif
+	}
 
 	// call this function here to disable default render threads creation of bgfx
 	bgfx::renderFrame();
@@ -271,7 +331,11 @@ int Application::run()
 	while (bgfx::RenderFrame::NoContext != bgfx::renderFrame());
 	_logicThread.shutdown();
 
-	SDL_DestroyWindow(_sdlWindow);
+	if (_sdlWindow)
+	{
+		SDL_DestroyWindow(_sdlWindow);
+		_sdlWindow = nullptr;
+	}
 	SDL_Quit();
 
 	return _logicThread.getExitCode();
@@ -279,6 +343,11 @@ int Application::run()
 
 void Application::updateDeltaTime()
 {
+	if (_fixedFrameTime > 0.0)
+	{
+		_deltaTime = _fixedFrameTime;
+		return;
+	}
 	double currentTime = bx::getHPCounter() / _frequency;
 	_deltaTime = currentTime - _lastTime;
 	// in case of system timer api error
@@ -289,7 +358,7 @@ void Application::updateDeltaTime()
 	}
 }
 
-#if BX_PLATFORM_ANDROID || BX_PLATFORM_OSX || BX_PLATFORM_WINDOWS
+#if BX_PLATFORM_ANDROID || BX_PLATFORM_OSX || BX_PLATFORM_WINDOWS || BX_PLATFORM_LINUX
 void Application::updateWindowSize()
 {
 	SDL_GL_GetDrawableSize(_sdlWindow, &_bufferWidth, &_bufferHeight);
@@ -307,7 +376,7 @@ void Application::updateWindowSize()
 	_visualHeight = _winHeight;
 #endif // BX_PLATFORM_WINDOWS
 }
-#endif // BX_PLATFORM_OSX || BX_PLATFORM_WINDOWS
+#endif // BX_PLATFORM_ANDROID || BX_PLATFORM_OSX || BX_PLATFORM_WINDOWS || BX_PLATFORM_LINUX
 
 #if BX_PLATFORM_ANDROID
 const string& Application::getAPKPath() const
@@ -342,6 +411,11 @@ double Application::getCPUTime() const
 	return _cpuTime;
 }
 
+double Application::getFrameJitter() const
+{
+	return _frameJitter;
+}
+
 double Application::getTotalTime() const
 {
 	return _totalTime;
@@ -353,12 +427,35 @@ void Application::makeTimeNow()
 	_lastTime = bx::getHPCounter() / _frequency;
 }
 
+void Application::waitForNextFrame()
+{
+	double targetTime = _lastTime + 1.0 / _maxFPS;
+	/* sleep in 1 ms slices while the remaining time can still
+	 hold a whole slice, the measured slice cost adapts to the
+	 system timer resolution and scheduler latency */
+	for (double currentTime = getCurrentTime();
+		targetTime - currentTime > _sleepCost;
+		currentTime = getCurrentTime())
+	{
+		SDL_Delay(1);
+		double cost = getCurrentTime() - currentTime;
+		_sleepCost = cost > _sleepCost ? cost : _sleepCost * 0.95 + cost * 0.05;
+	}
+	// let a spike of sleep cost fade out even when no slice fits
+	_sleepCost = std::max(_sleepCost * 0.99, 0.001);
+	// spin for the rest sub-millisecond
+	while (getCurrentTime() < targetTime);
+	updateDeltaTime();
+	_frameJitter = std::abs(_deltaTime - 1.0 / _maxFPS);
+}
+
 void Application::shutdown()
 {
 	switch (Switch::hash(getPlatform()))
 	{
 		case "Windows"_hash:
 		case "macOS"_hash:
+		case "Linux"_hash:
 			_renderEvent.post("Quit"_slice);
 			break;
 	}
@@ -397,18 +494,22 @@ int Application::mainLogic(bx::Thread* thread, void* userData)
 		Error("Director failed to initialize!");
 		return 1;
 	}
-	Timer::create()->start(0, [app]()
+	if (!app->_headless)
 	{
-		app->invokeInRender([app]()
+		Timer::create()->start(0, [app]()
 		{
-			SDL_ShowWindow(app->_sdlWindow);
+			app->invokeInRender([app]()
+			{
+				SDL_ShowWindow(app->_sdlWindow);
+			});
 		});
-	});
+	}
 	SharedPoolManager.pop();
 
 	bool running = true;
 	while (running)
 	{
+		DORA_PROFILE("Frame");
 		SharedPoolManager.push();
 		// poll events from render thread
 		for (Own<QEvent> event = app->_logicEvent.poll();
@@ -455,18 +556,22 @@ int Application::mainLogic(bx::Thread* thread, void* userData)
 
 		// advance to next frame. rendering thread will be kicked to
 		// process submitted rendering primitives.
-		app->_frame = bgfx::frame();
+		{
+			DORA_PROFILE("bgfx::frame");
+			app->_frame = bgfx::frame();
+		}
 
-		// limit for max FPS
-		if (app->_fpsLimited)
+		// limit for max FPS, no waiting with fixed frame time
+		if (app->_fpsLimited && app->_fixedFrameTime <= 0.0)
 		{
-			do
-			{
-				app->updateDeltaTime();
-			}
-			while (app->getDeltaTime() < 1.0/app->_maxFPS);
+			DORA_PROFILE("FPS Limit");
+			app->waitForNextFrame();
+		}
+		else
+		{
+			app->updateDeltaTime();
+			app->_frameJitter = 0.0;
 		}
-		else app->updateDeltaTime();
 		app->makeTimeNow();
 	}
 
@@ -484,12 +589,14 @@ const Slice Application::getPlatform() const
 	return "macOS"_slice;
 #elif BX_PLATFORM_IOS
 	return "iOS"_slice;
+#elif BX_PLATFORM_LINUX
+	return "Linux"_slice;
 #else
 	return "Unknown"_slice;
 #endif
 }
 
-#if BX_PLATFORM_OSX || BX_PLATFORM_WINDOWS || BX_PLATFORM_ANDROID
+#if BX_PLATFORM_OSX || BX_PLATFORM_WINDOWS || BX_PLATFORM_ANDROID || BX_PLATFORM_LINUX
 void Application::setupSdlWindow()
 {
 	SDL_SysWMinfo wmi;
@@ -502,6 +609,9 @@ void Application::setupSdlWindow()
 	pd.nwh = wmi.info.win.window;
 #elif BX_PLATFORM_ANDROID
 	pd.nwh = wmi.info.android.window;
+#elif BX_PLATFORM_LINUX
+	pd.ndt = wmi.info.x11.display;
+	pd.nwh = r_cast<void*>(s_cast<uintptr_t>(wmi.info.x11.window));
 #endif // BX_PLATFORM
 #if BX_PLATFORM_WINDOWS
 	float hdpi = DEFAULT_WIN_DPI, vdpi = DEFAULT_WIN_DPI;
@@ -523,7 +633,7 @@ void Application::setupSdlWindow()
 	bgfx::setPlatformData(pd);
 	updateWindowSize();
 }
-#endif // BX_PLATFORM_OSX || BX_PLATFORM_WINDOWS || BX_PLATFORM_ANDROID
+#endif // BX_PLATFORM_OSX || BX_PLATFORM_WINDOWS || BX_PLATFORM_ANDROID || BX_PLATFORM_LINUX
 
 NS_DOROTHY_END
 
@@ -535,6 +645,13 @@ int main(int argc, char *argv[])
 }
 #endif // BX_PLATFORM_OSX || BX_PLATFORM_ANDROID || BX_PLATFORM_IOS
 
+#if BX_PLATFORM_LINUX
+int main(int argc, char *argv[])
+{
+	return SharedApplication.run(argc, argv);
+}
+#endif // BX_PLATFORM_LINUX
+
 #if BX_PLATFORM_WINDOWS
 
 #if DORA_DEBUG
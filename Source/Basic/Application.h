@@ -34,6 +34,9 @@ public:
 	PROPERTY_READONLY(double, EclapsedTime);
 	PROPERTY_READONLY(double, CurrentTime);
 	PROPERTY_READONLY(double, CPUTime);
+	/** @brief absolute difference between the last frame time and the
+	 target frame time 1/MaxFPS when frame rate is limited. */
+	PROPERTY_READONLY(double, FrameJitter);
 	PROPERTY_READONLY(double, TotalTime);
 	PROPERTY_READONLY(const Slice, Platform);
 	PROPERTY_READONLY_CALL(Uint32, Rand);
@@ -44,9 +47,16 @@ public:
 	PROPERTY(Uint32, MinFPS);
 	PROPERTY(Uint32, Seed);
 	PROPERTY_BOOL(FPSLimited);
+	/** @brief run without window and GPU using bgfx Noop renderer,
+	 should be set before calling run(). */
+	PROPERTY_BOOL(Headless);
+	/** @brief advance each frame with this time step instead of the
+	 measured wall time when positive, for deterministic simulations. */
+	PROPERTY(double, FixedFrameTime);
 	SDLEventHandler eventHandler;
 	QuitHandler quitHandler;
 	int run();
+	int run(int argc, const char* const argv[]);
 	void shutdown();
 	void invokeInRender(const function<void()>& func);
 	void invokeInLogic(const function<void()>& func);
@@ -68,9 +78,11 @@ protected:
 	void updateDeltaTime();
 	void updateWindowSize();
 	void makeTimeNow();
+	void waitForNextFrame();
 	void setupSdlWindow();
 private:
 	bool _fpsLimited;
+	bool _headless;
 	int _visualWidth;
 	int _visualHeight;
 	int _winWidth;
@@ -85,7 +97,10 @@ private:
 	double _lastTime;
 	double _deltaTime;
 	double _cpuTime;
+	double _frameJitter;
+	double _sleepCost;
 	double _totalTime;
+	double _fixedFrameTime;
 	bx::Thread _logicThread;
 	EventQueue _logicEvent;
 	EventQueue _renderEvent;
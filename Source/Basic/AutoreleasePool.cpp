@@ -20,10 +20,18 @@ void PoolManager::clear()
 {
 	stack<Ref<AutoreleasePool>> emptyStack;
 	_releasePoolStack.swap(emptyStack);
+	_freePools.clear();
 }
 
 void PoolManager::push()
 {
+	/* reuse pools popped before to avoid allocations every frame */
+	if (!_freePools.empty())
+	{
+		_releasePoolStack.push(_freePools.back());
+		_freePools.pop_back();
+		return;
+	}
 	AutoreleasePool* pool = new AutoreleasePool();
 	_releasePoolStack.push(MakeRef(pool));
 	pool->release();
@@ -33,7 +41,10 @@ void PoolManager::pop()
 {
 	if (!_releasePoolStack.empty())
 	{
+		Ref<AutoreleasePool> pool = _releasePoolStack.top();
 		_releasePoolStack.pop();
+		pool->clear();
+		_freePools.push_back(pool);
 	}
 }
 
@@ -31,6 +31,7 @@ private:
 		RefVector<Object> _managedObjects;
 	};
 	stack<Ref<AutoreleasePool>> _releasePoolStack;
+	vector<Ref<AutoreleasePool>> _freePools;
 	SINGLETON_REF(PoolManager, ObjectBase);
 };
 
@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "FileSystem/mkdir.h"
 #include "FileSystem/tinydir.h"
 #include "Common/Async.h"
+#include "Common/Task.h"
 
 #include <fstream>
 using std::ofstream;
@@ -23,6 +24,8 @@ using std::ofstream;
 #if BX_PLATFORM_ANDROID
 #include "Zip/Support/ZipUtils.h"
 static Dorothy::Own<ZipFile> g_apkFile;
+// zip file reading is not thread safe
+static std::mutex g_apkMutex;
 #endif // BX_PLATFORM_ANDROID
 
 static void releaseFileData(void* _ptr, void* _userData)
@@ -42,27 +45,21 @@ Content::~Content()
 
 OwnArray<Uint8> Content::loadFile(String filename)
 {
-	SharedAsyncThread.FileIO.pause();
 	Sint64 size = 0;
 	Uint8* data = Content::_loadFileUnsafe(filename, size);
-	SharedAsyncThread.FileIO.resume();
 	return OwnArray<Uint8>(data, s_cast<size_t>(size));
 }
 
 const bgfx::Memory* Content::loadFileBX(String filename)
 {
-	SharedAsyncThread.FileIO.pause();
 	Sint64 size = 0;
 	Uint8* data = Content::_loadFileUnsafe(filename, size);
-	SharedAsyncThread.FileIO.resume();
 	return bgfx::makeRef(data, (uint32_t)size, releaseFileData);
 }
 
 void Content::copyFile(String src, String dst)
 {
-	SharedAsyncThread.FileIO.pause();
 	Content::copyFileUnsafe(src, dst);
-	SharedAsyncThread.FileIO.resume();
 }
 
 void Content::saveToFile(String filename, String content)
@@ -194,6 +191,7 @@ string Content::getFullPath(String filename)
 		return targetFile;
 	}
 
+	std::lock_guard<std::mutex> lock(_pathMutex);
 	auto it  = _fullPathCache.find(targetFile);
 	if (it != _fullPathCache.end())
 	{
@@ -230,6 +228,7 @@ void Content::insertSearchPath(int index, String path)
 	{
 		searchPath.append("/");
 	}
+	std::lock_guard<std::mutex> lock(_pathMutex);
 	_searchPaths.insert(_searchPaths.begin() + index, searchPath);
 	_fullPathCache.clear();
 }
@@ -241,6 +240,7 @@ void Content::addSearchPath(String path)
 	{
 		searchPath.append("/");
 	}
+	std::lock_guard<std::mutex> lock(_pathMutex);
 	_searchPaths.push_back(searchPath);
 }
 
@@ -251,6 +251,7 @@ void Content::removeSearchPath(String path)
 	{
 		realPath.append("/");
 	}
+	std::lock_guard<std::mutex> lock(_pathMutex);
 	for (auto it = _searchPaths.begin(); it != _searchPaths.end(); ++it)
 	{
 		if (*it == realPath)
@@ -264,8 +265,11 @@ void Content::removeSearchPath(String path)
 
 void Content::setSearchPaths(const vector<string>& searchPaths)
 {
-	_searchPaths.clear();
-	_fullPathCache.clear();
+	{
+		std::lock_guard<std::mutex> lock(_pathMutex);
+		_searchPaths.clear();
+		_fullPathCache.clear();
+	}
 	for (const string& searchPath : searchPaths)
 	{
 		Content::addSearchPath(searchPath);
@@ -356,6 +360,17 @@ void Content::loadFileAsync(String filename, const function<void(String)>& callb
 	});
 }
 
+Task<OwnArray<Uint8>> Content::loadFileAsync(String filename)
+{
+	string fileStr = filename;
+	return Task<OwnArray<Uint8>>::run([fileStr, this]()
+	{
+		Sint64 size = 0;
+		Uint8* buffer = this->_loadFileUnsafe(fileStr, size);
+		return OwnArray<Uint8>(buffer, s_cast<size_t>(size));
+	}, AsyncPriority::High);
+}
+
 void Content::loadFileAsyncBX(String filename, const function<void(const bgfx::Memory*)>& callback)
 {
 	Content::loadFileAsyncUnsafe(filename, [callback](Uint8* buffer, Sint64 size)
@@ -433,6 +448,7 @@ vector<string> Content::getDirEntries(String path, bool isFolder)
 #if BX_PLATFORM_ANDROID
 	if (fullPath[0] != '/')
 	{
+		std::lock_guard<std::mutex> lock(g_apkMutex);
 		return g_apkFile->getDirEntries(fullPath, isFolder);
 	}
 #endif // BX_PLATFORM_ANDROID
@@ -465,10 +481,7 @@ vector<string> Content::getDirEntries(String path, bool isFolder)
 
 Uint8* Content::loadFileUnsafe(String filename, Sint64& size)
 {
-	SharedAsyncThread.FileIO.pause();
-	Uint8* data = Content::_loadFileUnsafe(filename, size);
-	SharedAsyncThread.FileIO.resume();
-	return data;
+	return Content::_loadFileUnsafe(filename, size);
 }
 
 #if BX_PLATFORM_ANDROID
@@ -492,6 +505,7 @@ Uint8* Content::_loadFileUnsafe(String filename, Sint64& size)
 	string fullPath = Content::getFullPath(filename);
 	if (fullPath[0] != '/')
 	{
+		std::lock_guard<std::mutex> lock(g_apkMutex);
 		data = g_apkFile->getFileData(fullPath, r_cast<unsigned long*>(&size));
 	}
 	else
@@ -529,6 +543,7 @@ void Content::loadFileByChunks(String filename, const std::function<void(Uint8*,
 	string fullPath = Content::getFullPath(filename);
 	if (fullPath[0] != '/')
 	{
+		std::lock_guard<std::mutex> lock(g_apkMutex);
 		g_apkFile->getFileDataByChunks(fullPath, handler);
 	}
 	else
@@ -570,6 +585,7 @@ bool Content::isFileExist(String strFilePath)
 			// Didn't find "assets/" at the beginning of the path, adding it.
 			strPath.insert(0, _assetPath);
 		}
+		std::lock_guard<std::mutex> lock(g_apkMutex);
 		if (g_apkFile->fileExists(strPath))
 		{
 			found = true;
@@ -589,6 +605,7 @@ bool Content::isFileExist(String strFilePath)
 
 bool Content::isPathFolder(String path)
 {
+	std::lock_guard<std::mutex> lock(g_apkMutex);
 	return g_apkFile->isFolder(path);
 }
 
@@ -653,7 +670,36 @@ Content::Content()
 }
 #endif // BX_PLATFORM_OSX || BX_PLATFORM_IOS
 
-#if BX_PLATFORM_WINDOWS || BX_PLATFORM_OSX || BX_PLATFORM_IOS
+#if BX_PLATFORM_LINUX
+Content::Content()
+{
+	char* currentPath = SDL_GetBasePath();
+	_assetPath = currentPath;
+	SDL_free(currentPath);
+
+	char* prefPath = SDL_GetPrefPath(DORA_DEFAULT_ORG_NAME, DORA_DEFAULT_APP_NAME);
+	_writablePath = prefPath;
+	SDL_free(prefPath);
+}
+
+bool Content::isFileExist(String filePath)
+{
+	string strPath = filePath;
+	if (!Content::isAbsolutePath(strPath))
+	{
+		strPath.insert(0, _assetPath);
+	}
+	struct stat buf;
+	return ::stat(strPath.c_str(), &buf) == 0;
+}
+
+bool Content::isAbsolutePath(String strPath)
+{
+	return !strPath.empty() && strPath[0] == '/';
+}
+#endif // BX_PLATFORM_LINUX
+
+#if BX_PLATFORM_WINDOWS || BX_PLATFORM_OSX || BX_PLATFORM_IOS || BX_PLATFORM_LINUX
 Uint8* Content::_loadFileUnsafe(String filename, Sint64& size)
 {
 	if (filename.empty()) return nullptr;
@@ -699,9 +745,9 @@ bool Content::isPathFolder(String path)
 	}
 	return false;
 }
-#endif // BX_PLATFORM_WINDOWS || BX_PLATFORM_OSX || BX_PLATFORM_IOS
+#endif // BX_PLATFORM_WINDOWS || BX_PLATFORM_OSX || BX_PLATFORM_IOS || BX_PLATFORM_LINUX
 
-#if BX_PLATFORM_WINDOWS || BX_PLATFORM_ANDROID
+#if BX_PLATFORM_WINDOWS || BX_PLATFORM_ANDROID || BX_PLATFORM_LINUX
 string Content::getFullPathForDirectoryAndFilename(String directory, String filename)
 {
 	string fullPath = (Content::isAbsolutePath(directory) ? Slice::Empty : _assetPath);
@@ -712,6 +758,6 @@ string Content::getFullPathForDirectoryAndFilename(String directory, String file
 	}
 	return fullPath;
 }
-#endif // BX_PLATFORM_WINDOWS || BX_PLATFORM_ANDROID
+#endif // BX_PLATFORM_WINDOWS || BX_PLATFORM_ANDROID || BX_PLATFORM_LINUX
 
 NS_DOROTHY_END
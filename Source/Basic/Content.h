@@ -8,8 +8,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #pragma once
 
+#include <mutex>
+
 NS_DOROTHY_BEGIN
 
+template <class T>
+class Task;
+
 class Content
 {
 public:
@@ -35,6 +40,7 @@ public:
 	void addSearchPath(String path);
 	void removeSearchPath(String path);
 	void loadFileAsync(String filename, const function<void(String)>& callback);
+	Task<OwnArray<Uint8>> loadFileAsync(String filename);
 	void loadFileAsyncBX(String filename, const function<void(const bgfx::Memory*)>& callback);
 	void copyFileAsync(String src, String dst, const function<void()>& callback);
 	void saveToFileAsync(String filename, String content, const function<void()>& callback);
@@ -58,6 +64,7 @@ private:
 	string _writablePath;
 	vector<string> _searchPaths;
 	unordered_map<string, string> _fullPathCache;
+	std::mutex _pathMutex;
 	SINGLETON_REF(Content, Application);
 };
 
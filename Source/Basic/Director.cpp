@@ -27,24 +27,30 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "nanovg/nanovg_bgfx.h"
 #include "Entity/Entity.h"
 #include "Basic/VGRender.h"
+#include "Basic/FrameProfiler.h"
+#include "Common/FrameArena.h"
 
 NS_DOROTHY_BEGIN
 
 Director::Director():
+_displayStats(false),
+_nvgDirty(false),
+_stoped(false),
+_fixedFPS(60),
+_maxFixedSteps(5),
+_fixedAccumulator(0.0),
+_fixedAlpha(0.0f),
+_clearColor(0xff000000),
+_camStack(Array::create()),
 _systemScheduler(Scheduler::create()),
 _scheduler(Scheduler::create()),
 _postScheduler(Scheduler::create()),
 _postSystemScheduler(Scheduler::create()),
-_camStack(Array::create()),
-_clearColor(0xff000000),
-_displayStats(false),
-_nvgDirty(false),
-_stoped(false),
+_fixedScheduler(Scheduler::create()),
+_timerWheel(New<TimerWheel>()),
 _nvgContext(nullptr)
 {
-	Camera* defaultCamera = Camera2D::create("Default"_slice);
-	defaultCamera->Updated += std::make_pair(this, &Director::markDirty);
-	_camStack->add(defaultCamera);
+	_camStack->add(Camera2D::create("Default"_slice));
 }
 
 Director::~Director()
@@ -136,6 +142,46 @@ Scheduler* Director::getPostSystemScheduler() const
 	return _postSystemScheduler;
 }
 
+Scheduler* Director::getFixedScheduler() const
+{
+	return _fixedScheduler;
+}
+
+TimerWheel* Director::getTimerWheel() const
+{
+	return _timerWheel.get();
+}
+
+void Director::setFixedFPS(Uint32 var)
+{
+	_fixedFPS = std::max(var, 1u);
+}
+
+Uint32 Director::getFixedFPS() const
+{
+	return _fixedFPS;
+}
+
+void Director::setMaxFixedSteps(Uint32 var)
+{
+	_maxFixedSteps = std::max(var, 1u);
+}
+
+Uint32 Director::getMaxFixedSteps() const
+{
+	return _maxFixedSteps;
+}
+
+double Director::getFixedDeltaTime() const
+{
+	return 1.0 / _fixedFPS;
+}
+
+float Director::getFixedAlpha() const
+{
+	return _fixedAlpha;
+}
+
 double Director::getDeltaTime() const
 {
 	// only accept frames drop to min FPS
@@ -144,24 +190,16 @@ double Director::getDeltaTime() const
 
 void Director::pushCamera(Camera* var)
 {
-	Camera* lastCamera = getCurrentCamera();
-	lastCamera->Updated -= std::make_pair(this, &Director::markDirty);
-	var->Updated += std::make_pair(this, &Director::markDirty);
 	_camStack->add(var);
-	markDirty();
 }
 
 void Director::popCamera()
 {
-	Camera* lastCamera = getCurrentCamera();
-	lastCamera->Updated -= std::make_pair(this, &Director::markDirty);
 	_camStack->removeLast();
 	if (_camStack->isEmpty())
 	{
 		_camStack->add(Camera2D::create("Default"_slice));
 	}
-	getCurrentCamera()->Updated += std::make_pair(this, &Director::markDirty);
-	markDirty();
 }
 
 bool Director::removeCamera(Camera* camera)
@@ -180,13 +218,8 @@ bool Director::removeCamera(Camera* camera)
 
 void Director::clearCamera()
 {
-	Camera* lastCamera = getCurrentCamera();
-	lastCamera->Updated -= std::make_pair(this, &Director::markDirty);
 	_camStack->clear();
-	Camera2D* defaultCamera = Camera2D::create("Default"_slice);
-	defaultCamera->Updated += std::make_pair(this, &Director::markDirty);
-	_camStack->add(defaultCamera);
-	markDirty();
+	_camStack->add(Camera2D::create("Default"_slice));
 }
 
 Camera* Director::getCurrentCamera() const
@@ -199,18 +232,6 @@ const Matrix& Director::getViewProjection() const
 	return *_viewProjs.top();
 }
 
-static void registerTouchHandler(Node* target)
-{
-	target->traverseVisible([](Node* node)
-	{
-		if (node->isTouchEnabled())
-		{
-			SharedTouchDispatcher.add(node->getTouchHandler());
-		}
-		return false;
-	});
-}
-
 bool Director::init()
 {
 	SharedView.reset();
@@ -248,6 +269,8 @@ void Director::mainLoop()
 {
 	if (_stoped) return;
 
+	DORA_PROFILE("Director::mainLoop");
+
 	/* push default view projection */
 	Matrix viewProj;
 	Camera* camera = getCurrentCamera();
@@ -262,53 +285,88 @@ void Director::mainLoop()
 	pushViewProjection(viewProj, [&]()
 	{
 		/* update system logic */
-		_systemScheduler->update(getDeltaTime());
+		{
+			DORA_PROFILE("SystemScheduler");
+			_systemScheduler->update(getDeltaTime());
+		}
+		{
+			DORA_PROFILE("TimerWheel");
+			_timerWheel->update(getDeltaTime());
+		}
 		/* update game logic */
 		SharedImGui.begin();
-		_scheduler->update(getDeltaTime());
-		_postScheduler->update(getDeltaTime());
+		{
+			DORA_PROFILE("FixedScheduler");
+			/* fixed steps follow the game time scale, so pausing
+			 or slowing the scheduler also pauses or slows physics */
+			updateFixedStep(getDeltaTime() * _scheduler->getTimeScale());
+		}
+		{
+			DORA_PROFILE("Scheduler");
+			_scheduler->update(getDeltaTime());
+		}
+		{
+			DORA_PROFILE("PostScheduler");
+			_postScheduler->update(getDeltaTime());
+		}
 		SharedKeyboard.update();
 		SharedImGui.end();
 
-		_postSystemScheduler->update(getDeltaTime());
-
-		/* handle ImGui touch */
-		SharedTouchDispatcher.add(SharedImGui.getTarget());
-		SharedTouchDispatcher.dispatch();
+		{
+			DORA_PROFILE("PostSystemScheduler");
+			_postSystemScheduler->update(getDeltaTime());
+		}
 
 		Size viewSize = SharedView.getSize();
 		Matrix ortho;
 		bx::mtxOrtho(ortho, 0, viewSize.width, 0, viewSize.height, -1000.0f, 1000.0f, 0,
 			bgfx::getCaps()->homogeneousDepth);
 
-		/* handle ui touch */
-		if (_ui)
 		{
-			registerTouchHandler(_ui);
-			pushViewProjection(ortho, []()
+			DORA_PROFILE("TouchDispatch");
+
+			/* handle ImGui touch */
+			SharedTouchDispatcher.add(SharedImGui.getTarget());
+			SharedTouchDispatcher.dispatch();
+
+			/* handle ui touch */
+			if (_ui)
+			{
+				SharedTouchDispatcher.add(_ui);
+				pushViewProjection(ortho, []()
+				{
+					SharedTouchDispatcher.dispatch();
+				});
+			}
+
+			/* handle post node touch */
+			if (_postNode)
 			{
+				SharedTouchDispatcher.add(_postNode);
 				SharedTouchDispatcher.dispatch();
-			});
-		}
+			}
 
-		/* handle post node touch */
-		if (_postNode)
-		{
-			registerTouchHandler(_postNode);
-			SharedTouchDispatcher.dispatch();
+			/* handle scene tree touch */
+			if (_entry)
+			{
+				SharedTouchDispatcher.add(_entry);
+				SharedTouchDispatcher.dispatch();
+				SharedTouchDispatcher.clearEvents();
+			}
 		}
 
-		/* handle scene tree touch */
-		if (_entry)
+		/* update world matrices of the dirty nodes */
 		{
-			registerTouchHandler(_entry);
-			SharedTouchDispatcher.dispatch();
-			SharedTouchDispatcher.clearEvents();
+			DORA_PROFILE("Transform");
+			Node::updateWorlds(_entry);
+			Node::updateWorlds(_postNode);
+			Node::updateWorlds(_ui);
 		}
 
 		/* do render */
 		if (SharedView.isPostProcessNeeded())
 		{
+			DORA_PROFILE("Render");
 			/* initialize RT */
 			if (!_renderTarget ||
 				_renderTarget->getWidth() != viewSize.width ||
@@ -332,11 +390,9 @@ void Director::mainLoop()
 			/* render RT, post node and ui node */
 			SharedView.pushName("Main"_slice, [&]()
 			{
-				bgfx::ViewId viewId = SharedView.getId();
 				/* RT */
 				pushViewProjection(ortho, [&]()
 				{
-					bgfx::setViewTransform(viewId, nullptr, getViewProjection());
 					_renderTarget->setPosition({viewSize.width/2.0f, viewSize.height/2.0f});
 					_renderTarget->visit();
 					SharedRendererManager.flush();
@@ -344,7 +400,6 @@ void Director::mainLoop()
 				/* post node */
 				if (_postNode)
 				{
-					bgfx::setViewTransform(viewId, nullptr, getViewProjection());
 					_postNode->visit();
 					SharedRendererManager.flush();
 				}
@@ -353,7 +408,6 @@ void Director::mainLoop()
 				{
 					pushViewProjection(ortho, [&]()
 					{
-						bgfx::setViewTransform(viewId, nullptr, getViewProjection());
 						_ui->visit();
 						SharedRendererManager.flush();
 					});
@@ -367,6 +421,7 @@ void Director::mainLoop()
 		}
 		else
 		{
+			DORA_PROFILE("Render");
 			/* release unused RT */
 			if (_renderTarget)
 			{
@@ -380,11 +435,18 @@ void Director::mainLoop()
 				bgfx::setViewClear(viewId,
 					BGFX_CLEAR_COLOR | BGFX_CLEAR_DEPTH | BGFX_CLEAR_STENCIL,
 					_clearColor.toRGBA());
-				bgfx::setViewTransform(viewId, nullptr, getViewProjection());
 				/* scene tree */
-				if (_entry) _entry->visit();
+				if (_entry)
+				{
+					DORA_PROFILE("Visit Entry");
+					_entry->visit();
+				}
 				/* post node */
-				if (_postNode) _postNode->visit();
+				if (_postNode)
+				{
+					DORA_PROFILE("Visit PostNode");
+					_postNode->visit();
+				}
 				SharedRendererManager.flush();
 			});
 
@@ -393,13 +455,11 @@ void Director::mainLoop()
 			{
 				SharedView.pushName("UI"_slice, [&]()
 				{
-					bgfx::ViewId viewId = SharedView.getId();
 					/* ui node */
 					if (_ui)
 					{
 						pushViewProjection(ortho, [&]()
 						{
-							bgfx::setViewTransform(viewId, nullptr, getViewProjection());
 							_ui->visit();
 							SharedRendererManager.flush();
 						});
@@ -416,6 +476,7 @@ void Director::mainLoop()
 		/* render NanoVG */
 		if (_nvgContext && _nvgDirty)
 		{
+			DORA_PROFILE("NanoVG");
 			_nvgDirty = false;
 			SharedView.pushName("NanoVG"_slice, [&]()
 			{
@@ -425,13 +486,19 @@ void Director::mainLoop()
 		}
 
 		/* render imgui */
-		SharedImGui.render();
+		{
+			DORA_PROFILE("ImGui");
+			SharedImGui.render();
+		}
 		SharedView.clear();
 		if (_uiTouchHandler)
 		{
 			_uiTouchHandler->clear();
 		}
 	});
+
+	/* release transient memory of this frame */
+	SharedFrameArena.reset();
 }
 
 void Director::displayStats()
@@ -459,44 +526,80 @@ void Director::displayStats()
 	bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mBackbuffer: \x1b[15;m%d x %d", s_cast<int>(size.width), s_cast<int>(size.height));
 	bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mDraw call: \x1b[15;m%d", stats->numDraw);
 	static int frames = 0;
-	static double cpuTime = 0, gpuTime = 0, deltaTime = 0;
+	static double cpuTime = 0, gpuTime = 0, deltaTime = 0, jitter = 0, maxJitter = 0;
 	cpuTime += SharedApplication.getCPUTime();
+	jitter += SharedApplication.getFrameJitter();
+	maxJitter = std::max(maxJitter, SharedApplication.getFrameJitter());
 	gpuTime += std::abs(double(stats->gpuTimeEnd) - double(stats->gpuTimeBegin)) / double(stats->gpuTimerFreq);
 	deltaTime += SharedApplication.getDeltaTime();
 	frames++;
 	static double lastCpuTime = 0, lastGpuTime = 0, lastDeltaTime = 1000.0 / SharedApplication.getMaxFPS();
+	static double lastJitter = 0, lastMaxJitter = 0;
 	bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mCPU time: \x1b[15;m%.1f ms", lastCpuTime);
 	if (lastGpuTime > 0.0)
 	{
 		bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mGPU time: \x1b[15;m%.1f ms", lastGpuTime);
 	}
 	bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mDelta time: \x1b[15;m%.1f ms", lastDeltaTime);
+	if (SharedApplication.isFPSLimited())
+	{
+		bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mJitter: \x1b[15;m%.2f ms (max %.2f ms)", lastJitter, lastMaxJitter);
+	}
 	if (frames == SharedApplication.getMaxFPS())
 	{
 		lastCpuTime = 1000.0 * cpuTime / frames;
 		lastGpuTime = 1000.0 * gpuTime / frames;
 		lastDeltaTime = 1000.0 * deltaTime / frames;
+		lastJitter = 1000.0 * jitter / frames;
+		lastMaxJitter = 1000.0 * maxJitter;
 		frames = 0;
-		cpuTime = gpuTime = deltaTime = 0.0;
+		cpuTime = gpuTime = deltaTime = jitter = maxJitter = 0.0;
 	}
+	bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mFrame Memory: \x1b[15;m%d / %d kb", s_cast<int>(SharedFrameArena.getPeakSize() / 1024), s_cast<int>(SharedFrameArena.getCapacity() / 1024));
 	bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mC++ Object: \x1b[15;m%d", Object::getCount());
 	bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mLua Object: \x1b[15;m%d", Object::getLuaRefCount());
 	bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mLua Callback: \x1b[15;m%d", Object::getLuaCallbackCount());
 	// bgfx::dbgTextPrintf(dbgViewId, ++row, 0x0f, "\x1b[11;mMemory Pool: \x1b[15;m%d kb", MemoryPool::getCapacity()/1024);
 }
 
+void Director::updateFixedStep(double deltaTime)
+{
+	/* run fixed logic with constant time step, catch up at most
+	 max fixed steps per frame and drop the rest of the lagging time */
+	double fixedDeltaTime = getFixedDeltaTime();
+	_fixedAccumulator += deltaTime;
+	Uint32 steps = 0;
+	while (_fixedAccumulator >= fixedDeltaTime && steps < _maxFixedSteps)
+	{
+		_fixedScheduler->update(fixedDeltaTime);
+		_fixedAccumulator -= fixedDeltaTime;
+		steps++;
+	}
+	if (_fixedAccumulator >= fixedDeltaTime)
+	{
+		_fixedAccumulator = std::fmod(_fixedAccumulator, fixedDeltaTime);
+	}
+	/* interpolation factor between the last two fixed steps for rendering */
+	_fixedAlpha = s_cast<float>(_fixedAccumulator / fixedDeltaTime);
+}
+
 void Director::pushViewProjection(const Matrix& viewProj)
 {
+	/* batches pick up the view projection when flushed,
+	 so they must not span a view projection change */
+	SharedRendererManager.flush();
 	_viewProjs.push(New<Matrix>(viewProj));
 }
 
 void Director::popViewProjection()
 {
+	SharedRendererManager.flush();
 	_viewProjs.pop();
 }
 
 void Director::clear()
 {
+	_timerWheel->clear();
 	if (_ui)
 	{
 		_ui->onExit();
@@ -580,7 +683,6 @@ void Director::handleSDLEvent(const SDL_Event& event)
 					case SDL_WINDOWEVENT_SIZE_CHANGED:
 					{
 						SharedView.reset();
-						markDirty();
 						Event::send("AppSizeChanged"_slice);
 						break;
 					}
@@ -17,6 +17,7 @@ struct NVGcontext;
 NS_DOROTHY_BEGIN
 
 class Scheduler;
+class TimerWheel;
 class Node;
 class Camera;
 class RenderTarget;
@@ -38,6 +39,12 @@ public:
 	PROPERTY_READONLY(Scheduler*, SystemScheduler);
 	PROPERTY_READONLY(Scheduler*, PostScheduler);
 	PROPERTY_READONLY(Scheduler*, PostSystemScheduler);
+	PROPERTY_READONLY(Scheduler*, FixedScheduler);
+	PROPERTY_READONLY(TimerWheel*, TimerWheel);
+	PROPERTY(Uint32, FixedFPS);
+	PROPERTY(Uint32, MaxFixedSteps);
+	PROPERTY_READONLY(double, FixedDeltaTime);
+	PROPERTY_READONLY(float, FixedAlpha);
 	PROPERTY_READONLY(double, DeltaTime);
 	PROPERTY_READONLY(const Matrix&, ViewProjection);
 	bool init();
@@ -63,12 +70,17 @@ protected:
 	Director();
 	void clear();
 	void displayStats();
+	void updateFixedStep(double deltaTime);
 	void pushViewProjection(const Matrix& viewProj);
 	void popViewProjection();
 private:
 	bool _displayStats;
 	bool _nvgDirty;
 	bool _stoped;
+	Uint32 _fixedFPS;
+	Uint32 _maxFixedSteps;
+	double _fixedAccumulator;
+	float _fixedAlpha;
 	Color _clearColor;
 	Ref<Node> _ui;
 	Ref<Node> _postNode;
@@ -78,6 +90,8 @@ private:
 	Ref<Scheduler> _scheduler;
 	Ref<Scheduler> _postScheduler;
 	Ref<Scheduler> _postSystemScheduler;
+	Ref<Scheduler> _fixedScheduler;
+	Own<TimerWheel> _timerWheel;
 	Ref<RenderTarget> _renderTarget;
 	Own<UITouchHandler> _uiTouchHandler;
 	stack<Own<Matrix>> _viewProjs;
@@ -0,0 +1,161 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "Const/Header.h"
+#include "Basic/FrameProfiler.h"
+#include "Basic/Application.h"
+#include "Basic/Content.h"
+
+NS_DOROTHY_BEGIN
+
+FrameProfiler::FrameProfiler():
+_enabled(false),
+_capacity(65536),
+_head(0),
+_count(0)
+{ }
+
+void FrameProfiler::setEnabled(bool var)
+{
+	_enabled = var;
+	if (_enabled && _records.empty())
+	{
+		_records.resize(_capacity);
+	}
+}
+
+bool FrameProfiler::isEnabled() const
+{
+	return _enabled;
+}
+
+void FrameProfiler::setCapacity(Uint32 var)
+{
+	AssertIf(var == 0, "profiler capacity should be greater than zero.");
+	_capacity = var;
+	_records.clear();
+	_head = _count = 0;
+	if (_enabled)
+	{
+		_records.resize(_capacity);
+	}
+}
+
+Uint32 FrameProfiler::getCapacity() const
+{
+	return _capacity;
+}
+
+Uint32 FrameProfiler::getCount() const
+{
+	return _count;
+}
+
+Uint32 FrameProfiler::getNameId(String name)
+{
+	auto it = _nameIds.find(name);
+	if (it != _nameIds.end())
+	{
+		return it->second;
+	}
+	Uint32 nameId = s_cast<Uint32>(_names.size());
+	_names.push_back(name);
+	_nameIds[name] = nameId;
+	return nameId;
+}
+
+void FrameProfiler::push(String name)
+{
+	if (!_enabled) return;
+	push(getNameId(name));
+}
+
+void FrameProfiler::push(Uint32 nameId)
+{
+	if (!_enabled) return;
+	_scopes.push_back({nameId, SharedApplication.getCurrentTime()});
+}
+
+void FrameProfiler::pop()
+{
+	if (_scopes.empty()) return;
+	const Scope& scope = _scopes.back();
+	if (_enabled)
+	{
+		Record& record = _records[_head];
+		record.nameId = scope.nameId;
+		record.frame = SharedApplication.getFrame();
+		record.depth = s_cast<Uint32>(_scopes.size() - 1);
+		record.start = scope.start;
+		record.duration = SharedApplication.getCurrentTime() - scope.start;
+		_head = (_head + 1) % _capacity;
+		_count = std::min(_count + 1, _capacity);
+	}
+	_scopes.pop_back();
+}
+
+void FrameProfiler::clear()
+{
+	_head = _count = 0;
+}
+
+static void escapeJson(fmt::memory_buffer& out, const string& str)
+{
+	for (char ch : str)
+	{
+		switch (ch)
+		{
+			case '"': case '\\': out.push_back('\\'); out.push_back(ch); break;
+			case '\n': out.push_back('\\'); out.push_back('n'); break;
+			case '\t': out.push_back('\\'); out.push_back('t'); break;
+			default: out.push_back(ch); break;
+		}
+	}
+}
+
+string FrameProfiler::getTrace() const
+{
+	fmt::memory_buffer out;
+	fmt::format_to(out, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+	fmt::format_to(out, "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{{\"name\":\"Logic\"}}}}");
+	Uint32 first = (_head + _capacity - _count) % _capacity;
+	for (Uint32 i = 0; i < _count; i++)
+	{
+		const Record& record = _records[(first + i) % _capacity];
+		fmt::format_to(out, ",\n{{\"name\":\"");
+		escapeJson(out, _names[record.nameId]);
+		fmt::format_to(out, "\",\"cat\":\"dora\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{\"frame\":{},\"depth\":{}}}}}",
+			record.start * 1000000.0, record.duration * 1000000.0, record.frame, record.depth);
+	}
+	fmt::format_to(out, "]}}\n");
+	return fmt::to_string(out);
+}
+
+void FrameProfiler::dumpTrace(String filename)
+{
+	SharedContent.saveToFile(filename, getTrace());
+}
+
+ProfileScope::ProfileScope(Uint32 nameId):
+_recording(SharedFrameProfiler.isEnabled())
+{
+	if (_recording)
+	{
+		SharedFrameProfiler.push(nameId);
+	}
+}
+
+ProfileScope::~ProfileScope()
+{
+	if (_recording)
+	{
+		SharedFrameProfiler.pop();
+	}
+}
+
+NS_DOROTHY_END
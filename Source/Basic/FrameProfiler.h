@@ -0,0 +1,82 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+NS_DOROTHY_BEGIN
+
+/** @brief Records nested named time scopes of the logic thread into
+ a ring buffer which can be dumped as a chrome://tracing JSON file.
+ Scopes are only recorded while the profiler is enabled.
+ @example
+	void Foo::update()
+	{
+		DORA_PROFILE("Foo::update");
+		...
+	}
+ */
+class FrameProfiler
+{
+public:
+	virtual ~FrameProfiler() { }
+	PROPERTY_BOOL(Enabled);
+	/** @brief max number of scope records kept, the oldest records
+	 are overwritten when exceeded. */
+	PROPERTY(Uint32, Capacity);
+	PROPERTY_READONLY(Uint32, Count);
+	Uint32 getNameId(String name);
+	void push(String name);
+	void push(Uint32 nameId);
+	void pop();
+	void clear();
+	string getTrace() const;
+	void dumpTrace(String filename);
+protected:
+	FrameProfiler();
+private:
+	struct Record
+	{
+		Uint32 nameId;
+		Uint32 frame;
+		Uint32 depth;
+		double start;
+		double duration;
+	};
+	struct Scope
+	{
+		Uint32 nameId;
+		double start;
+	};
+	bool _enabled;
+	Uint32 _capacity;
+	Uint32 _head;
+	Uint32 _count;
+	vector<Record> _records;
+	vector<Scope> _scopes;
+	vector<string> _names;
+	unordered_map<string, Uint32> _nameIds;
+	SINGLETON_REF(FrameProfiler, Application);
+};
+
+#define SharedFrameProfiler \
+	Dorothy::Singleton<Dorothy::FrameProfiler>::shared()
+
+class ProfileScope
+{
+public:
+	ProfileScope(Uint32 nameId);
+	~ProfileScope();
+private:
+	bool _recording;
+};
+
+#define DORA_PROFILE(name) \
+	static const Uint32 BX_CONCATENATE(__profileId, __LINE__) = SharedFrameProfiler.getNameId(name); \
+	Dorothy::ProfileScope BX_CONCATENATE(__profileScope, __LINE__)(BX_CONCATENATE(__profileId, __LINE__))
+
+NS_DOROTHY_END
@@ -10,6 +10,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Basic/Object.h"
 #include "Basic/AutoreleasePool.h"
 #include "Lua/ToLua/tolua++.h"
+#include <mutex>
 
 NS_DOROTHY_BEGIN
 
@@ -36,6 +37,8 @@ public:
 	Uint32 luaRefCount;
 	stack<Uint32> availableLuaRefs;
 	stack<Uint32> availableIds;
+	// objects are also created and destroyed by async workers
+	std::mutex idMutex;
 	SINGLETON_REF(ObjectBase, AsyncLogThread);
 };
 
@@ -68,6 +71,7 @@ _luaRef(0),
 _weak(nullptr)
 {
 	auto& info = SharedObjectBase;
+	std::lock_guard<std::mutex> lock(info.idMutex);
 	if (info.availableIds.empty())
 	{
 		_id = ++info.maxIdCount;
@@ -83,6 +87,7 @@ Object::~Object()
 {
 	auto& info = SharedObjectBase;
 	AssertIf(_managed, "object is still managed when destroyed.");
+	std::lock_guard<std::mutex> lock(info.idMutex);
 	info.availableIds.push(_id);
 	if (_luaRef != 0)
 	{
@@ -158,6 +163,16 @@ void Object::cleanup()
 	if (_weak) _weak->target = nullptr;
 }
 
+void Object::resetWeakRef()
+{
+	if (_weak)
+	{
+		_weak->target = nullptr;
+		_weak->release();
+		_weak = nullptr;
+	}
+}
+
 Uint32 Object::getId() const
 {
 	return _id;
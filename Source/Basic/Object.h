@@ -51,6 +51,9 @@ public:
 	void autoretain();
 protected:
 	Object();
+	/** @brief detach the weak reference cleared by cleanup(),
+	 so an object reused after cleanup gets a new one. */
+	void resetWeakRef();
 private:
 	bool _managed;
 	Uint32 _id; // object id, each object has unique one
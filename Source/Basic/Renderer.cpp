@@ -9,6 +9,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Const/Header.h"
 #include "Basic/Renderer.h"
 #include "Node/Node.h"
+#include "Basic/FrameProfiler.h"
 
 NS_DOROTHY_BEGIN
 
@@ -29,6 +30,7 @@ void RendererManager::setCurrent(Renderer* var)
 {
 	if (_currentRenderer && _currentRenderer != var)
 	{
+		DORA_PROFILE("RendererManager::flush");
 		_currentRenderer->render();
 	}
 	_currentRenderer = var;
@@ -48,6 +50,7 @@ void RendererManager::flush()
 {
 	if (_currentRenderer)
 	{
+		DORA_PROFILE("RendererManager::flush");
 		_currentRenderer->render();
 		_currentRenderer = nullptr;
 	}
@@ -70,24 +73,23 @@ bool RendererManager::isGrouping() const
 
 void RendererManager::pushGroupItem(Node* item)
 {
-	vector<Node*>* renderGroup = _renderGroups.top().get();
-	renderGroup->push_back(item);
+	_renderGroups.top().push_back(item);
 }
 
 void RendererManager::pushGroup(Uint32 capacity)
 {
-	_renderGroups.push(New<vector<Node*>>());
-	_renderGroups.top()->reserve(s_cast<size_t>(capacity));
+	_renderGroups.emplace();
+	_renderGroups.top().reserve(s_cast<size_t>(capacity));
 }
 
 void RendererManager::popGroup()
 {
-	vector<Node*>* renderGroup = _renderGroups.top().get();
-	std::stable_sort(renderGroup->begin(), renderGroup->end(), [](Node* nodeA, Node* nodeB)
+	FrameVector<Node*>& renderGroup = _renderGroups.top();
+	std::stable_sort(renderGroup.begin(), renderGroup.end(), [](Node* nodeA, Node* nodeB)
 	{
 		return nodeA->getRenderOrder() < nodeB->getRenderOrder();
 	});
-	for (Node* node : *renderGroup)
+	for (Node* node : renderGroup)
 	{
 		node->render();
 	}
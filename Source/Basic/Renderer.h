@@ -9,6 +9,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #pragma once
 
 #include "Support/Geometry.h"
+#include "Common/FrameArena.h"
 
 NS_DOROTHY_BEGIN
 
@@ -54,8 +55,8 @@ protected:
 private:
 	stack<Uint32> _stencilStates;
 	Renderer* _currentRenderer;
-	stack<Own<vector<Node*>>> _renderGroups;
-	SINGLETON_REF(RendererManager, BGFXDora);
+	stack<FrameVector<Node*>, vector<FrameVector<Node*>>> _renderGroups;
+	SINGLETON_REF(RendererManager, BGFXDora, FrameArena);
 };
 
 #define SharedRendererManager \
@@ -9,6 +9,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Const/Header.h"
 #include "Basic/Scheduler.h"
 #include "Animation/Action.h"
+#include "Animation/Tween.h"
 #include "Support/Array.h"
 #include "Node/Node.h"
 #include "Basic/Director.h"
@@ -25,19 +26,31 @@ public:
 		return func(deltaTime);
 	}
 	function<bool (double)> func;
-	list<Ref<Object>>::iterator it;
 	CREATE_FUNC(FuncWrapper);
 protected:
 	FuncWrapper(const function<bool (double)>& func):func(func) { }
 	DORA_TYPE_OVERRIDE(FuncWrapper);
 };
 
-vector<Ref<Object>> Scheduler::_updateItems;
+const Scheduler::Handle Scheduler::InvalidHandle = 0;
+const Uint32 Scheduler::Item::Removed = UINT32_MAX;
+
+static inline Scheduler::Handle makeHandle(Uint32 slot, Uint32 generation)
+{
+	return (s_cast<Scheduler::Handle>(generation) << 32) | slot;
+}
 
 Scheduler::Scheduler():
 _deltaTime(0.0),
 _timeScale(1.0f),
-_actionList(Array::create())
+_updating(false),
+_phaseIndex(0),
+_scheduledCount(0),
+_actionList(Array::create()),
+_tweens(New<TweenBatch>())
+{ }
+
+Scheduler::~Scheduler()
 { }
 
 void Scheduler::setTimeScale(float value)
@@ -55,29 +68,143 @@ double Scheduler::getDeltaTime() const
 	return _deltaTime;
 }
 
-void Scheduler::schedule(Object* object)
+Uint32 Scheduler::getScheduledCount() const
+{
+	return _scheduledCount;
+}
+
+TweenBatch* Scheduler::getTweens() const
+{
+	return _tweens.get();
+}
+
+Scheduler::Phase* Scheduler::getPhase(int priority)
+{
+	auto it = std::lower_bound(_phases.begin(), _phases.end(), priority, [](const Own<Phase>& phase, int priority)
+	{
+		return phase->priority < priority;
+	});
+	if (it != _phases.end() && (*it)->priority == priority)
+	{
+		return it->get();
+	}
+	Uint32 index = s_cast<Uint32>(it - _phases.begin());
+	if (_updating && index <= _phaseIndex)
+	{
+		/* keep pointing to the phase being updated */
+		_phaseIndex++;
+	}
+	Phase* phase = new Phase{priority, 0, {}};
+	_phases.insert(it, Own<Phase>(phase));
+	return phase;
+}
+
+Scheduler::Handle Scheduler::add(Object* object, int priority, bool keyed)
+{
+	Uint32 slotIndex;
+	if (_freeSlots.empty())
+	{
+		slotIndex = s_cast<Uint32>(_slots.size());
+		_slots.push_back({1, 0, nullptr});
+	}
+	else
+	{
+		slotIndex = _freeSlots.back();
+		_freeSlots.pop_back();
+	}
+	Phase* phase = getPhase(priority);
+	Slot& slot = _slots[slotIndex];
+	slot.index = s_cast<Uint32>(phase->items.size());
+	slot.phase = phase;
+	phase->items.push_back({MakeRef(object), slotIndex, keyed});
+	_scheduledCount++;
+	return makeHandle(slotIndex, slot.generation);
+}
+
+void Scheduler::remove(Uint32 slotIndex)
+{
+	Slot& slot = _slots[slotIndex];
+	Phase* phase = slot.phase;
+	Item& item = phase->items[slot.index];
+	if (item.keyed)
+	{
+		_objectHandles.erase(item.object.get());
+	}
+	/* leave a hole to keep the order, the object being updated
+	 is kept alive until the update ends */
+	item.slot = Item::Removed;
+	if (!_updating) item.object = nullptr;
+	phase->holes++;
+	slot.phase = nullptr;
+	slot.generation++;
+	_freeSlots.push_back(slotIndex);
+	_scheduledCount--;
+}
+
+void Scheduler::compact(Phase* phase)
 {
-	// O(1) insert operation
-	_updateMap[object] = _updateList.insert(_updateList.end(), MakeRef(object));
+	auto& items = phase->items;
+	auto it = std::remove_if(items.begin(), items.end(), [](const Item& item)
+	{
+		return item.slot == Item::Removed;
+	});
+	items.erase(it, items.end());
+	for (Uint32 i = 0; i < items.size(); i++)
+	{
+		_slots[items[i].slot].index = i;
+	}
+	phase->holes = 0;
 }
 
-void Scheduler::schedule(const function<bool (double)>& handler)
+Scheduler::Handle Scheduler::schedule(Object* object, int priority)
 {
-	FuncWrapper* func = FuncWrapper::create(handler);
-	func->it = _updateList.insert(_updateList.end(), Ref<Object>(func));
+	auto it = _objectHandles.find(object);
+	if (it != _objectHandles.end())
+	{
+		return it->second;
+	}
+	Handle handle = add(object, priority, true);
+	_objectHandles[object] = handle;
+	return handle;
+}
+
+Scheduler::Handle Scheduler::schedule(const function<bool (double)>& handler, int priority)
+{
+	return add(FuncWrapper::create(handler), priority, false);
 }
 
 void Scheduler::unschedule(Object* object)
 {
-	auto it = _updateMap.find(object);
-	if (it != _updateMap.end())
+	auto it = _objectHandles.find(object);
+	if (it != _objectHandles.end())
 	{
-		// O(1) remove operation
-		_updateList.erase(it->second);
-		_updateMap.erase(it);
+		unschedule(it->second);
 	}
 }
 
+void Scheduler::unschedule(Handle handle)
+{
+	if (isScheduled(handle))
+	{
+		remove(s_cast<Uint32>(handle & UINT32_MAX));
+	}
+}
+
+bool Scheduler::isScheduled(Handle handle) const
+{
+	Uint32 slotIndex = s_cast<Uint32>(handle & UINT32_MAX);
+	Uint32 generation = s_cast<Uint32>(handle >> 32);
+	return slotIndex < _slots.size() &&
+		_slots[slotIndex].phase &&
+		_slots[slotIndex].generation == generation;
+}
+
+static Uint32 actionEndEvent()
+{
+	static const Uint32 eventId = Event::intern("ActionEnd"_slice);
+	return eventId;
+}
+
 void Scheduler::schedule(Action* action)
 {
 	if (action && action->_target && !action->isRunning())
@@ -90,7 +217,15 @@ void Scheduler::schedule(Action* action)
 			Ref<Node> targetRef(action->_target);
 			unschedule(actionRef);
 			targetRef->removeAction(actionRef);
-			targetRef->emit("ActionEnd"_slice, actionRef.get(), targetRef.get());
+			targetRef->emit(actionEndEvent(), actionRef.get(), targetRef.get());
+		}
+		else if (!action->_reversed && !action->_paused && action->_speed == 1.0f &&
+			action->_action->isTweenable(action->getDuration()))
+		{
+			/* plain property actions are stepped by the tween batch,
+			 the action only keeps the time until it ends */
+			action->_action->tween(_tweens.get(), action->_target, action, action->_eclapsed);
+			action->_tweened = true;
 		}
 	}
 }
@@ -101,6 +236,7 @@ void Scheduler::unschedule(Action* action)
 	if (action && action->_target && action->isRunning()
 		&& _actionList->get(action->_order) == action)
 	{
+		action->untween();
 		_actionList->set(action->_order, nullptr);
 		action->_order = Action::InvalidOrder;
 	}
@@ -111,6 +247,9 @@ bool Scheduler::update(double deltaTime)
 	// not save _it and _deltaTime on the stack memory
 	_deltaTime = deltaTime * _timeScale;
 
+	/* update batched property tweens */
+	_tweens->update(s_cast<float>(_deltaTime));
+
 	/* update actions */
 	int i = 0, count = _actionList->getCount();
 	while (i < count)
@@ -118,18 +257,21 @@ bool Scheduler::update(double deltaTime)
 		Ref<Action> action(_actionList->get(i).to<Action>());
 		if (action)
 		{
-			if (!action->isPaused())
+			Node* target = action->_target;
+			/* culled nodes may opt out of stepping their actions */
+			if (!action->isPaused() && !(target->isPauseWhenCulled() && target->isCulled()))
 			{
 				int lastIndex = action->_order;
 				action->_eclapsed += s_cast<float>(_deltaTime) * action->_speed;
-				if (action->updateProgress())
+				if ((!action->_tweened || action->_eclapsed >= action->getDuration()) &&
+					action->updateProgress())
 				{
 					if (action->_order == lastIndex)
 					{
 						Ref<Node> target(action->_target);
 						unschedule(action);
 						target->removeAction(action);
-						target->emit("ActionEnd"_slice, action.get(), target.get());
+						target->emit(actionEndEvent(), action.get(), target.get());
 					}
 				}
 			}
@@ -151,63 +293,274 @@ bool Scheduler::update(double deltaTime)
 		i++;
 	}
 
-	/* update scheduled items */
-	_updateItems.reserve(_updateList.size());
-	_updateItems.insert(_updateItems.begin(), _updateList.begin(), _updateList.end());
-	for (const auto& item : _updateItems)
+	/* update scheduled items phase by phase in place, items removed
+	 meanwhile are only marked. Items added to the phase being updated
+	 or an earlier one run from the next frame, items added to a later
+	 phase run in this frame. */
+	_updating = true;
+	for (_phaseIndex = 0; _phaseIndex < _phases.size(); _phaseIndex++)
 	{
-		if (item->update(_deltaTime))
+		Phase* phase = _phases[_phaseIndex].get();
+		size_t count = phase->items.size();
+		for (size_t i = 0; i < count; i++)
 		{
-			FuncWrapper* func = DoraCast<FuncWrapper>(item.get());
-			if (func)
+			if (phase->items[i].slot == Item::Removed) continue;
+			Object* object = phase->items[i].object.get();
+			if (object->update(_deltaTime))
 			{
-				_updateList.erase(func->it);
+				/* items may be reallocated by schedules during the update */
+				Uint32 slot = phase->items[i].slot;
+				if (slot != Item::Removed) remove(slot);
 			}
-			else unschedule(item);
 		}
 	}
-	_updateItems.clear();
+	_updating = false;
+	for (const auto& phase : _phases)
+	{
+		if (phase->holes > 0) compact(phase.get());
+	}
 	return false;
 }
 
-/* Timer */
-Timer::Timer():
-_time(0),
-_duration(0)
-{ }
+/* TimerWheel */
 
-bool Timer::isRunning() const
+const TimerWheel::Handle TimerWheel::InvalidHandle = 0;
+const Uint32 TimerWheel::None = UINT32_MAX;
+
+TimerWheel::TimerWheel(double tickInterval):
+_tickInterval(std::max(tickInterval, 1e-6)),
+_time(0.0),
+_count(0),
+_current(0)
+{
+	std::fill(std::begin(_buckets), std::end(_buckets), None);
+}
+
+double TimerWheel::getTickInterval() const
+{
+	return _tickInterval;
+}
+
+double TimerWheel::getTime() const
+{
+	return _time;
+}
+
+Uint32 TimerWheel::getCount() const
+{
+	return _count;
+}
+
+void TimerWheel::link(Uint32 index)
+{
+	Entry& entry = _entries[index];
+	Uint64 expire = entry.expire;
+	Uint64 delta = expire - _current;
+	Uint32 bucket;
+	if (delta < RootSize)
+	{
+		bucket = s_cast<Uint32>(expire & (RootSize - 1));
+	}
+	else
+	{
+		int level = 1;
+		while (level < Levels - 1 && delta >= (Uint64(1) << (RootBits + level * LevelBits)))
+		{
+			level++;
+		}
+		if (level == Levels - 1)
+		{
+			/* far timers wait in the top level and get placed again when it cascades */
+			expire = std::min(expire, _current + (Uint64(1) << (RootBits + level * LevelBits)) - 1);
+		}
+		Uint32 slot = s_cast<Uint32>((expire >> (RootBits + (level - 1) * LevelBits)) & (LevelSize - 1));
+		bucket = RootSize + (level - 1) * LevelSize + slot;
+	}
+	entry.bucket = bucket;
+	entry.prev = None;
+	entry.next = _buckets[bucket];
+	if (entry.next != None)
+	{
+		_entries[entry.next].prev = index;
+	}
+	_buckets[bucket] = index;
+}
+
+void TimerWheel::unlink(Uint32 index)
+{
+	Entry& entry = _entries[index];
+	if (entry.prev != None)
+	{
+		_entries[entry.prev].next = entry.next;
+	}
+	else
+	{
+		_buckets[entry.bucket] = entry.next;
+	}
+	if (entry.next != None)
+	{
+		_entries[entry.next].prev = entry.prev;
+	}
+}
+
+void TimerWheel::release(Uint32 index)
+{
+	Entry& entry = _entries[index];
+	entry.bucket = None;
+	entry.generation++;
+	_freeEntries.push_back(index);
+	_count--;
+}
+
+TimerWheel::Handle TimerWheel::add(double delay, const function<void()>& callback)
+{
+	Uint32 index;
+	if (_freeEntries.empty())
+	{
+		index = s_cast<Uint32>(_entries.size());
+		_entries.push_back({1, None, None, None, 0, nullptr});
+	}
+	else
+	{
+		index = _freeEntries.back();
+		_freeEntries.pop_back();
+	}
+	Entry& entry = _entries[index];
+	Uint64 expire = s_cast<Uint64>(std::ceil((_time + std::max(delay, 0.0)) / _tickInterval));
+	/* never fire in the tick that is being processed */
+	entry.expire = std::max(expire, _current + 1);
+	entry.callback = callback;
+	link(index);
+	_count++;
+	return (s_cast<Handle>(entry.generation) << 32) | index;
+}
+
+bool TimerWheel::isPending(Handle handle) const
+{
+	Uint32 index = s_cast<Uint32>(handle & UINT32_MAX);
+	Uint32 generation = s_cast<Uint32>(handle >> 32);
+	return index < _entries.size() &&
+		_entries[index].bucket != None &&
+		_entries[index].generation == generation;
+}
+
+bool TimerWheel::cancel(Handle handle)
 {
-	return _time < _duration;
+	if (!isPending(handle)) return false;
+	Uint32 index = s_cast<Uint32>(handle & UINT32_MAX);
+	unlink(index);
+	/* the callback may own objects that cancel timers when destroyed */
+	auto callback = std::move(_entries[index].callback);
+	_entries[index].callback = nullptr;
+	release(index);
+	return true;
 }
 
-bool Timer::update(double deltaTime)
+void TimerWheel::cascade(int level, Uint32 slot)
 {
-	_time += s_cast<float>(deltaTime);
-	if (_time >= _duration)
+	Uint32& bucket = _buckets[RootSize + (level - 1) * LevelSize + slot];
+	Uint32 index = bucket;
+	bucket = None;
+	while (index != None)
 	{
-		if (_callback)
+		Uint32 next = _entries[index].next;
+		link(index);
+		index = next;
+	}
+}
+
+void TimerWheel::tick()
+{
+	Uint32 slot = s_cast<Uint32>(_current & (RootSize - 1));
+	if (slot == 0)
+	{
+		for (int level = 1; level < Levels; level++)
 		{
-			_callback();
+			Uint32 upper = s_cast<Uint32>((_current >> (RootBits + (level - 1) * LevelBits)) & (LevelSize - 1));
+			cascade(level, upper);
+			if (upper != 0) break;
 		}
-		stop();
-		return true;
 	}
-	return false;
+	Uint32& bucket = _buckets[slot];
+	while (bucket != None)
+	{
+		Uint32 index = bucket;
+		unlink(index);
+		auto callback = std::move(_entries[index].callback);
+		_entries[index].callback = nullptr;
+		release(index);
+		if (callback)
+		{
+			callback();
+		}
+	}
+	_current++;
+}
+
+void TimerWheel::update(double deltaTime)
+{
+	_time += deltaTime;
+	Uint64 target = s_cast<Uint64>(_time / _tickInterval);
+	while (_current <= target)
+	{
+		if (_count == 0)
+		{
+			_current = target + 1;
+			break;
+		}
+		tick();
+	}
+}
+
+void TimerWheel::clear()
+{
+	vector<Entry> entries;
+	entries.swap(_entries);
+	_freeEntries.clear();
+	std::fill(std::begin(_buckets), std::end(_buckets), None);
+	_count = 0;
+	/* keep generations growing so that stale handles stay invalid */
+	_entries.reserve(entries.size());
+	for (const auto& entry : entries)
+	{
+		_entries.push_back({entry.generation + 1, None, None, None, 0, nullptr});
+	}
+	for (Uint32 i = s_cast<Uint32>(_entries.size()); i > 0; i--)
+	{
+		_freeEntries.push_back(i - 1);
+	}
+}
+
+/* Timer */
+Timer::Timer():
+_handle(TimerWheel::InvalidHandle)
+{ }
+
+bool Timer::isRunning() const
+{
+	return SharedDirector.getTimerWheel()->isPending(_handle);
 }
 
 void Timer::start(float duration, const function<void()>& callback)
 {
-	_time = 0.0f;
-	_duration = std::max(0.0f, duration);
-	_callback = callback;
-	SharedDirector.getSystemScheduler()->schedule(this);
+	stop();
+	auto self = MakeRef(this);
+	_handle = SharedDirector.getTimerWheel()->add(std::max(0.0f, duration), [self, callback]()
+	{
+		self->_handle = TimerWheel::InvalidHandle;
+		if (callback)
+		{
+			callback();
+		}
+	});
 }
 
 void Timer::stop()
 {
-	_time = _duration = 0.0f;
-	_callback = nullptr;
+	TimerWheel::Handle handle = _handle;
+	_handle = TimerWheel::InvalidHandle;
+	/* the wheel may hold the last reference to this timer */
+	SharedDirector.getTimerWheel()->cancel(handle);
 }
 
 NS_DOROTHY_END
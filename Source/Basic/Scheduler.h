@@ -13,48 +13,139 @@ NS_DOROTHY_BEGIN
 class Node;
 class Action;
 class Array;
+class TweenBatch;
 
+/** @brief Updates scheduled items in phases of ascending priorities.
+ Items of each phase are kept in a dense array addressed by generation
+ handles from a slot map. Removed items are left as holes and compacted
+ after the update, so items with the same priority are updated in the
+ order they were scheduled. */
 class Scheduler : public Object
 {
-	typedef list<Ref<Object>> UpdateList;
-	typedef unordered_map<Object*, UpdateList::iterator> UpdateMap;
 public:
+	typedef Uint64 Handle;
+	static const Handle InvalidHandle;
+	virtual ~Scheduler();
 	PROPERTY(float, TimeScale);
 	PROPERTY_READONLY(double, DeltaTime);
-	void schedule(Object* object);
-	void schedule(const function<bool (double)>& handler);
+	PROPERTY_READONLY(Uint32, ScheduledCount);
+	PROPERTY_READONLY(TweenBatch*, Tweens);
+	/** @brief schedule an object once, scheduling it again returns the same handle. */
+	Handle schedule(Object* object, int priority = 0);
+	Handle schedule(const function<bool (double)>& handler, int priority = 0);
 	void schedule(Action* action);
 	void unschedule(Object* object);
+	void unschedule(Handle handle);
 	void unschedule(Action* action);
+	bool isScheduled(Handle handle) const;
 	virtual bool update(double deltaTime) override;
 	CREATE_FUNC(Scheduler);
 protected:
 	Scheduler();
 private:
+	struct Item
+	{
+		Ref<Object> object;
+		Uint32 slot;
+		bool keyed;
+		static const Uint32 Removed;
+	};
+	struct Phase
+	{
+		int priority;
+		Uint32 holes;
+		vector<Item> items;
+	};
+	struct Slot
+	{
+		Uint32 generation;
+		Uint32 index;
+		Phase* phase;
+	};
+	Handle add(Object* object, int priority, bool keyed);
+	void remove(Uint32 slotIndex);
+	Phase* getPhase(int priority);
+	void compact(Phase* phase);
 	float _timeScale;
 	double _deltaTime;
-	UpdateList _updateList;
-	UpdateMap _updateMap;
+	bool _updating;
+	Uint32 _phaseIndex;
+	Uint32 _scheduledCount;
+	vector<Own<Phase>> _phases;
+	vector<Slot> _slots;
+	vector<Uint32> _freeSlots;
+	unordered_map<Object*, Handle> _objectHandles;
 	Ref<Array> _actionList;
-private:
-	static vector<Ref<Object>> _updateItems;
+	Own<TweenBatch> _tweens;
 	DORA_TYPE_OVERRIDE(Scheduler);
 };
 
+/** @brief Hierarchical timing wheel for delayed callbacks.
+ Time is quantized into ticks, each timer is linked into a bucket of
+ the level covering its remaining ticks and moves down a level when
+ the bucket above expires, so inserting and canceling are O(1) and
+ a tick only touches the timers whose bucket comes due. */
+class TimerWheel
+{
+public:
+	typedef Uint64 Handle;
+	static const Handle InvalidHandle;
+	TimerWheel(double tickInterval = 0.001);
+	PROPERTY_READONLY(double, TickInterval);
+	PROPERTY_READONLY(double, Time);
+	PROPERTY_READONLY(Uint32, Count);
+	Handle add(double delay, const function<void()>& callback);
+	bool cancel(Handle handle);
+	bool isPending(Handle handle) const;
+	void update(double deltaTime);
+	void clear();
+private:
+	enum
+	{
+		RootBits = 8,
+		LevelBits = 6,
+		Levels = 5,
+		RootSize = 1 << RootBits,
+		LevelSize = 1 << LevelBits,
+		BucketCount = RootSize + (Levels - 1) * LevelSize
+	};
+	static const Uint32 None;
+	struct Entry
+	{
+		Uint32 generation;
+		Uint32 prev;
+		Uint32 next;
+		Uint32 bucket;
+		Uint64 expire;
+		function<void()> callback;
+	};
+	void link(Uint32 index);
+	void unlink(Uint32 index);
+	void release(Uint32 index);
+	void cascade(int level, Uint32 bucket);
+	void tick();
+	double _tickInterval;
+	double _time;
+	Uint32 _count;
+	Uint64 _current;
+	vector<Entry> _entries;
+	vector<Uint32> _freeEntries;
+	Uint32 _buckets[BucketCount];
+};
+
+/** @brief Fires a callback once after a duration, pending timers
+ are kept alive by the timer wheel of the director. */
 class Timer : public Object
 {
 public:
 	PROPERTY_BOOL(Running);
-	virtual bool update(double deltaTime) override;
 	void start(float duration, const function<void()>& callback);
 	void stop();
 	CREATE_FUNC(Timer);
 protected:
 	Timer();
 private:
-	float _time;
-	float _duration;
-	function<void()> _callback;
+	TimerWheel::Handle _handle;
 	DORA_TYPE_OVERRIDE(Timer);
 };
 
@@ -43,7 +43,7 @@ struct nvg
 	static int CreateImage(int w, int h, int imageFlags, String filename);
 	static int CreateFont(String name);
 	static float TextBounds(float x, float y, String text, Dorothy::Rect& bounds);
-	static Rect TextBoxBounds(float x, float y, float breakRowWidth, String text);
+	static Dorothy::Rect TextBoxBounds(float x, float y, float breakRowWidth, String text);
 	static float Text(float x, float y, String text);
 	static void TextBox(float x, float y, float breakRowWidth, String text);
 	static void StrokeColor(Color color);
@@ -167,7 +167,6 @@ float View::getFieldOfView() const
 void View::updateProjection()
 {
 	bx::mtxProj(_projection, _fieldOfView, getAspectRatio(), _nearPlaneDistance, _farPlaneDistance, bgfx::getCaps()->homogeneousDepth);
-	SharedDirector.markDirty();
 }
 
 const Matrix& View::getProjection() const
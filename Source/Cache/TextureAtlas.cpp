@@ -0,0 +1,160 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "Const/Header.h"
+#include "Cache/TextureAtlas.h"
+#include "Support/Geometry.h"
+#include "Other/atlas.h"
+
+NS_DOROTHY_BEGIN
+
+/* PackedTexture */
+
+PackedTexture::PackedTexture(TextureAtlas* atlas, TextureAtlas::Page* page, Uint16 x, Uint16 y, const bgfx::TextureInfo& info):
+Texture2D(page->atlas->getTexture()->getHandle(), info, BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP),
+_atlas(atlas),
+_page(page),
+_x(x),
+_y(y)
+{ }
+
+PackedTexture::~PackedTexture()
+{
+	/* the handle belongs to the atlas page */
+	_handle = BGFX_INVALID_HANDLE;
+	const bgfx::TextureInfo& info = getInfo();
+	_atlas->release(_page, info.width * info.height);
+}
+
+void PackedTexture::getUV(const Rect& rect, float& left, float& top, float& right, float& bottom) const
+{
+	float size = s_cast<float>(_atlas->getPageSize());
+	left = (_x + rect.getX()) / size;
+	top = (_y + rect.getY()) / size;
+	right = (_x + rect.getX() + rect.getWidth()) / size;
+	bottom = (_y + rect.getY() + rect.getHeight()) / size;
+}
+
+/* TextureAtlas */
+
+TextureAtlas::TextureAtlas(Uint16 pageSize, Uint16 maxTextureSize, Uint32 maxPages):
+_pageSize(pageSize),
+_maxTextureSize(std::min(maxTextureSize, s_cast<Uint16>(pageSize / 2))),
+_maxPages(maxPages)
+{ }
+
+TextureAtlas::~TextureAtlas()
+{ }
+
+Uint16 TextureAtlas::getPageSize() const
+{
+	return _pageSize;
+}
+
+Uint16 TextureAtlas::getMaxTextureSize() const
+{
+	return _maxTextureSize;
+}
+
+Uint32 TextureAtlas::getPageCount() const
+{
+	return s_cast<Uint32>(_pages.size());
+}
+
+static vector<Uint8> extrude(Uint16 width, Uint16 height, const Uint8* pixels)
+{
+	/* surround the image with a copy of its border pixels,
+	 so linear filtering at the edges never blends in the empty gaps */
+	Uint32 paddedWidth = width + 2;
+	vector<Uint8> padded(paddedWidth * (height + 2) * 4);
+	for (Uint32 y = 0; y < s_cast<Uint32>(height + 2); y++)
+	{
+		Uint32 srcY = std::min(std::max(y, 1u) - 1, height - 1u);
+		const Uint8* src = pixels + srcY * width * 4;
+		Uint8* dst = padded.data() + y * paddedWidth * 4;
+		std::memcpy(dst, src, 4);
+		std::memcpy(dst + 4, src, width * 4);
+		std::memcpy(dst + (width + 1) * 4, src + (width - 1) * 4, 4);
+	}
+	return padded;
+}
+
+PackedTexture* TextureAtlas::add(Page* page, Uint16 width, Uint16 height, const Uint8* padded)
+{
+	Uint16 index = page->atlas->addRegion(width + 2, height + 2, padded);
+	if (index == UINT16_MAX)
+	{
+		Uint32 wasted = page->packedArea - page->liveArea;
+		if (wasted > page->packedArea / 2)
+		{
+			page->retired = true;
+		}
+		return nullptr;
+	}
+	const bgfx::AtlasRegion& region = page->atlas->getRegion(index);
+	bgfx::TextureInfo info;
+	bgfx::calcTextureSize(info, width, height, 0, false, false, 1, bgfx::TextureFormat::RGBA8);
+	Uint32 area = width * height;
+	page->liveCount++;
+	page->liveArea += area;
+	page->packedArea += area;
+	return PackedTexture::create(this, page, region.x + 1, region.y + 1, info);
+}
+
+PackedTexture* TextureAtlas::pack(Uint16 width, Uint16 height, const Uint8* pixels)
+{
+	if (width == 0 || height == 0 || width > _maxTextureSize || height > _maxTextureSize)
+	{
+		return nullptr;
+	}
+	vector<Uint8> padded = extrude(width, height, pixels);
+	/* fill the fullest pages first so that the sparse ones can drain */
+	vector<Page*> pages;
+	pages.reserve(_pages.size());
+	for (const auto& page : _pages)
+	{
+		if (!page->retired) pages.push_back(page.get());
+	}
+	std::sort(pages.begin(), pages.end(), [](Page* a, Page* b)
+	{
+		return a->liveArea > b->liveArea;
+	});
+	for (Page* page : pages)
+	{
+		if (PackedTexture* texture = add(page, width, height, padded.data()))
+		{
+			return texture;
+		}
+	}
+	if (_pages.size() >= _maxPages)
+	{
+		return nullptr;
+	}
+	Page* page = new Page{New<bgfx::Atlas>(_pageSize, bgfx::Atlas::RGBA8), 0, 0, 0, false};
+	_pages.push_back(Own<Page>(page));
+	return add(page, width, height, padded.data());
+}
+
+void TextureAtlas::release(Page* page, Uint32 area)
+{
+	page->liveCount--;
+	page->liveArea -= area;
+	if (page->liveCount == 0)
+	{
+		auto it = std::find_if(_pages.begin(), _pages.end(), [page](const Own<Page>& item)
+		{
+			return item.get() == page;
+		});
+		if (it != _pages.end())
+		{
+			_pages.erase(it);
+		}
+	}
+}
+
+NS_DOROTHY_END
@@ -0,0 +1,77 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include "Cache/TextureCache.h"
+
+namespace bgfx {
+class Atlas;
+}
+
+NS_DOROTHY_BEGIN
+
+class PackedTexture;
+
+/** @brief Packs small RGBA8 images into shared pages built on bgfx::Atlas,
+ so that sprites using different images batch into one draw call.
+ Each image is packed with its border pixels extruded by one texel,
+ so the linear filtered pages show no seams at the region edges.
+ Packed regions are never moved since sprites, particles and baked
+ subtrees keep their texture coordinates. Instead a page wasting more
+ than half of its packed area on released textures stops taking new
+ ones and is freed once its last texture is released. */
+class TextureAtlas
+{
+public:
+	TextureAtlas(Uint16 pageSize = 2048, Uint16 maxTextureSize = 256, Uint32 maxPages = 4);
+	~TextureAtlas();
+	PROPERTY_READONLY(Uint16, PageSize);
+	PROPERTY_READONLY(Uint16, MaxTextureSize);
+	PROPERTY_READONLY(Uint32, PageCount);
+	/** @brief copy the RGBA8 pixels into a page, returns nullptr when
+	 the image is too large or there is no room left. */
+	PackedTexture* pack(Uint16 width, Uint16 height, const Uint8* pixels);
+private:
+	struct Page
+	{
+		Own<bgfx::Atlas> atlas;
+		Uint32 liveCount;
+		Uint32 liveArea;
+		Uint32 packedArea;
+		bool retired;
+	};
+	PackedTexture* add(Page* page, Uint16 width, Uint16 height, const Uint8* padded);
+	void release(Page* page, Uint32 area);
+	Uint16 _pageSize;
+	Uint16 _maxTextureSize;
+	Uint32 _maxPages;
+	vector<Own<Page>> _pages;
+	friend class PackedTexture;
+};
+
+/** @brief A small texture living in a shared page of the texture atlas.
+ Its size is the size of the image it was packed from, texture rects
+ are mapped into the page with getUV(). */
+class PackedTexture : public Texture2D
+{
+public:
+	virtual ~PackedTexture();
+	virtual void getUV(const Rect& rect, float& left, float& top, float& right, float& bottom) const override;
+	CREATE_FUNC(PackedTexture);
+protected:
+	PackedTexture(TextureAtlas* atlas, TextureAtlas::Page* page, Uint16 x, Uint16 y, const bgfx::TextureInfo& info);
+private:
+	TextureAtlas* _atlas;
+	TextureAtlas::Page* _page;
+	Uint16 _x;
+	Uint16 _y;
+	DORA_TYPE_OVERRIDE(PackedTexture);
+};
+
+NS_DOROTHY_END
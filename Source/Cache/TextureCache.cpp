@@ -8,8 +8,11 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include "Const/Header.h"
 #include "Cache/TextureCache.h"
+#include "Cache/TextureAtlas.h"
 #include "Basic/Content.h"
 #include "Common/Async.h"
+#include "Common/Task.h"
+#include "Support/Geometry.h"
 #include "bimg/decode.h"
 
 NS_DOROTHY_BEGIN
@@ -80,6 +83,14 @@ Uint64 Texture2D::getFlags() const
 	return _flags;
 }
 
+void Texture2D::getUV(const Rect& rect, float& left, float& top, float& right, float& bottom) const
+{
+	left = rect.getX() / _info.width;
+	top = rect.getY() / _info.height;
+	right = (rect.getX() + rect.getWidth()) / _info.width;
+	bottom = (rect.getY() + rect.getHeight()) / _info.height;
+}
+
 Texture2D::~Texture2D()
 {
 	if (bgfx::isValid(_handle))
@@ -89,6 +100,54 @@ Texture2D::~Texture2D()
 	}
 }
 
+TextureCache::TextureCache():
+_atlasEnabled(false)
+{ }
+
+TextureCache::~TextureCache()
+{ }
+
+void TextureCache::setAtlasEnabled(bool var)
+{
+	_atlasEnabled = var;
+	if (var && !_atlas)
+	{
+		_atlas = New<TextureAtlas>();
+	}
+}
+
+bool TextureCache::isAtlasEnabled() const
+{
+	return _atlasEnabled;
+}
+
+TextureAtlas* TextureCache::getAtlas() const
+{
+	return _atlas.get();
+}
+
+Texture2D* TextureCache::pack(bimg::ImageContainer* imageContainer)
+{
+	if (!_atlasEnabled
+		|| imageContainer->m_format != bimg::TextureFormat::RGBA8
+		|| imageContainer->m_numMips > 1
+		|| imageContainer->m_numLayers > 1
+		|| imageContainer->m_depth > 1
+		|| imageContainer->m_cubeMap)
+	{
+		return nullptr;
+	}
+	Texture2D* texture = _atlas->pack(
+		s_cast<Uint16>(imageContainer->m_width),
+		s_cast<Uint16>(imageContainer->m_height),
+		s_cast<const Uint8*>(imageContainer->m_data));
+	if (texture)
+	{
+		bimg::imageFree(imageContainer);
+	}
+	return texture;
+}
+
 Texture2D* TextureCache::update(String name, Texture2D* texture)
 {
 	string fullPath = SharedContent.getFullPath(name);
@@ -120,6 +179,12 @@ Texture2D* TextureCache::update(String filename, const Uint8* data, Sint64 size)
 	bimg::ImageContainer* imageContainer = bimg::imageParse(&_allocator, data, s_cast<uint32_t>(size));
 	if (imageContainer)
 	{
+		if (Texture2D* texture = pack(imageContainer))
+		{
+			string fullPath = SharedContent.getFullPath(filename);
+			_textures[fullPath] = texture;
+			return texture;
+		}
 		Uint64 flags = BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
 		const bgfx::Memory* mem = bgfx::makeRef(
 			imageContainer->m_data, imageContainer->m_size,
@@ -163,60 +228,66 @@ Texture2D* TextureCache::load(String filename)
 }
 
 void TextureCache::loadAsync(String filename, const function<void(Texture2D*)>& handler)
+{
+	TextureCache::loadAsync(filename).done([handler](Texture2D* texture)
+	{
+		handler(texture);
+	});
+}
+
+Task<Texture2D*> TextureCache::loadAsync(String filename)
 {
 	string fullPath = SharedContent.getFullPath(filename);
 	auto it = _textures.find(fullPath);
 	if (it != _textures.end())
 	{
-		handler(it->second);
-		return;
+		return Task<Texture2D*>::resolved(it->second);
 	}
 	string file(filename);
-	SharedContent.loadFileAsyncUnsafe(fullPath, [this, file, handler](Uint8* data, Sint64 size)
+	return SharedContent.loadFileAsync(fullPath).thenAsync([this](OwnArray<Uint8>& data)
+	{
+		if (!data) return s_cast<bimg::ImageContainer*>(nullptr);
+		bimg::ImageContainer* imageContainer = bimg::imageParse(&_allocator, data, s_cast<uint32_t>(data.size()));
+		data.reset();
+		return imageContainer;
+	}).then([this, file](bimg::ImageContainer* imageContainer) -> Texture2D*
 	{
-		SharedAsyncThread.Loader.run([this, data, size]()
+		if (!imageContainer)
 		{
-			bimg::ImageContainer* imageContainer = bimg::imageParse(&_allocator, data, s_cast<uint32_t>(size));
-			delete [] data;
-			return Values::create(imageContainer);
-		}, [this, file, handler](Values* result)
+			Warn("texture format \"{}\" is not supported for \"{}\".", Slice(file).getFileExtension(), file);
+			return nullptr;
+		}
+		if (Texture2D* texture = pack(imageContainer))
 		{
-			bimg::ImageContainer* imageContainer;
-			result->get(imageContainer);
-			if (imageContainer)
-			{
-				Uint64 flags = BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
-				const bgfx::Memory* mem = bgfx::makeRef(
-					imageContainer->m_data, imageContainer->m_size,
-					releaseImage, imageContainer);
-				bgfx::TextureHandle handle = bgfx::createTexture2D(
-					s_cast<uint16_t>(imageContainer->m_width),
-					s_cast<uint16_t>(imageContainer->m_height),
-					imageContainer->m_numMips > 1,
-					imageContainer->m_numLayers,
-					s_cast<bgfx::TextureFormat::Enum>(imageContainer->m_format),
-					flags,
-					mem);
-				bgfx::TextureInfo info;
-				bgfx::calcTextureSize(info,
-					s_cast<uint16_t>(imageContainer->m_width),
-					s_cast<uint16_t>(imageContainer->m_height),
-					s_cast<uint16_t>(imageContainer->m_depth),
-					imageContainer->m_cubeMap,
-					imageContainer->m_numMips > 1,
-					imageContainer->m_numMips,
-					s_cast<bgfx::TextureFormat::Enum>(imageContainer->m_format));
-				Texture2D* texture = Texture2D::create(handle, info, flags);
-				string fullPath = SharedContent.getFullPath(file);
-				_textures[fullPath] = texture;
-				handler(texture);
-			}
-			else
-			{
-				Warn("texture format \"{}\" is not supported for \"{}\".", Slice(file).getFileExtension(), file);
-				handler(nullptr);
-			}
-		});
+			string fullPath = SharedContent.getFullPath(file);
+			_textures[fullPath] = texture;
+			return texture;
+		}
+		Uint64 flags = BGFX_SAMPLER_U_CLAMP | BGFX_SAMPLER_V_CLAMP;
+		const bgfx::Memory* mem = bgfx::makeRef(
+			imageContainer->m_data, imageContainer->m_size,
+			releaseImage, imageContainer);
+		bgfx::TextureHandle handle = bgfx::createTexture2D(
+			s_cast<uint16_t>(imageContainer->m_width),
+			s_cast<uint16_t>(imageContainer->m_height),
+			imageContainer->m_numMips > 1,
+			imageContainer->m_numLayers,
+			s_cast<bgfx::TextureFormat::Enum>(imageContainer->m_format),
+			flags,
+			mem);
+		bgfx::TextureInfo info;
+		bgfx::calcTextureSize(info,
+			s_cast<uint16_t>(imageContainer->m_width),
+			s_cast<uint16_t>(imageContainer->m_height),
+			s_cast<uint16_t>(imageContainer->m_depth),
+			imageContainer->m_cubeMap,
+			imageContainer->m_numMips > 1,
+			imageContainer->m_numMips,
+			s_cast<bgfx::TextureFormat::Enum>(imageContainer->m_format));
+		Texture2D* texture = Texture2D::create(handle, info, flags);
+		string fullPath = SharedContent.getFullPath(file);
+		_textures[fullPath] = texture;
+		return texture;
 	});
 }
 
@@ -8,8 +8,18 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #pragma once
 
+namespace bimg {
+struct ImageContainer;
+}
+
 NS_DOROTHY_BEGIN
 
+template <class T>
+class Task;
+
+class TextureAtlas;
+struct Rect;
+
 enum struct TextureWrap
 {
 	None,
@@ -37,6 +47,8 @@ public:
 	PROPERTY_READONLY(TextureWrap, VWrap);
 	PROPERTY_READONLY(Uint64, Flags);
 	virtual ~Texture2D();
+	/** @brief map a rect in texture pixels to the normalized coordinates of the texture handle. */
+	virtual void getUV(const Rect& rect, float& left, float& top, float& right, float& bottom) const;
 	CREATE_FUNC(Texture2D);
 protected:
 	Texture2D(bgfx::TextureHandle handle, const bgfx::TextureInfo& info, Uint64 flags);
@@ -50,21 +62,28 @@ private:
 class TextureCache
 {
 public:
-	virtual ~TextureCache() { }
+	virtual ~TextureCache();
+	/** @brief pack small RGBA8 textures loaded from now on into shared atlas pages. */
+	PROPERTY_BOOL(AtlasEnabled);
+	PROPERTY_READONLY(TextureAtlas*, Atlas);
 	Texture2D* update(String name, Texture2D* texture);
 	Texture2D* update(String filename, const Uint8* data, Sint64 size);
 	Texture2D* get(String filename);
 	/** @brief support format .jpg .png .dds .pvr .ktx */
 	Texture2D* load(String filename);
 	void loadAsync(String filename, const function<void(Texture2D*)>& handler);
+	Task<Texture2D*> loadAsync(String filename);
     bool unload(Texture2D* texture);
     bool unload(String filename);
     bool unload();
     void removeUnused();
 protected:
-	TextureCache() { }
+	TextureCache();
 private:
+	Texture2D* pack(bimg::ImageContainer* imageContainer);
+	bool _atlasEnabled;
 	bx::DefaultAllocator _allocator;
+	Own<TextureAtlas> _atlas;
 	unordered_map<string, Ref<Texture2D>> _textures;
 	SINGLETON_REF(TextureCache, BGFXDora);
 };
@@ -11,6 +11,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Basic/Content.h"
 #include "Other/rapidxml_sax3.hpp"
 #include "Common/Async.h"
+#include "Common/Task.h"
 
 NS_DOROTHY_BEGIN
 
@@ -77,49 +78,43 @@ public:
 		}
 	}
 	void loadAsync(String filename, const function<void(T* item)>& handler)
+	{
+		loadAsync(filename).done([handler](T* item)
+		{
+			handler(item);
+		});
+	}
+	Task<T*> loadAsync(String filename)
 	{
 		string fullPath = SharedContent.getFullPath(filename);
 		auto it = _dict.find(fullPath);
 		if (it != _dict.end())
 		{
-			handler(it->second);
+			return Task<T*>::resolved(it->second);
 		}
-		else
+		auto parser = prepareParser(filename);
+		return SharedContent.loadFileAsync(fullPath).thenAsync([parser](OwnArray<Uint8>& data)
 		{
-			string file(filename);
-			SharedContent.loadFileAsyncUnsafe(file, [this, file, handler](Uint8* data, Sint64 size)
+			Ref<T> result;
+			if (data)
 			{
-				if (data)
+				try
 				{
-					auto parser = prepareParser(file);
-					SharedAsyncThread.Loader.run([this, file, parser, data, size]()
-					{
-						OwnArray<Uint8> dataOwner(data, s_cast<size_t>(size));
-						Ref<T> result;
-						try
-						{
-							parser->parse(r_cast<char*>(data), s_cast<int>(size));
-							result = parser->getItem();
-						}
-						catch (rapidxml::parse_error error)
-						{
-							Warn("xml parse error: {}, at: {}", error.what(), error.where<char>() - r_cast<const char*>(data));
-						}
-						return Values::create(result);
-					}, [this, handler, file](Values* values)
-					{
-						Ref<T> item;
-						values->get(item);
-						_dict[file] = item;
-						handler(item);
-					});
+					parser->parse(r_cast<char*>(data.get()), s_cast<int>(data.size()));
+					result = parser->getItem();
 				}
-				else
+				catch (rapidxml::parse_error error)
 				{
-					handler(nullptr);
+					Warn("xml parse error: {}, at: {}", error.what(), error.where<char>() - r_cast<const char*>(data.get()));
 				}
-			});
-		}
+				data.reset();
+			}
+			return result;
+		}).then([this, fullPath](Ref<T>& item) -> T*
+		{
+			if (item) _dict[fullPath] = item;
+			return item;
+		});
 	}
 	T* update(String name, String content)
 	{
@@ -10,6 +10,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Common/Async.h"
 #include "Basic/Director.h"
 #include "Basic/Scheduler.h"
+#include <thread>
 
 NS_DOROTHY_BEGIN
 
@@ -208,4 +209,190 @@ void Async::cancel()
 	_workers.clear();
 }
 
+/* AsyncThread */
+
+static thread_local AsyncThread* g_currentPool = nullptr;
+static thread_local Uint32 g_currentWorker = 0;
+
+AsyncThread::AsyncThread():
+_scheduled(false),
+_stopped(false),
+_nextWorker(0)
+{
+	// leave cores for the logic and render threads
+	int cpuCount = SDL_GetCPUCount();
+	_workerCount = s_cast<Uint32>(std::max(2, cpuCount - 2));
+}
+
+AsyncThread::~AsyncThread()
+{
+	AsyncThread::stop();
+}
+
+Uint32 AsyncThread::getWorkerCount() const
+{
+	return _workerCount;
+}
+
+void AsyncThread::stop()
+{
+	if (_workers.empty() || _stopped) return;
+	_stopped = true;
+	_jobSemaphore.post(_workerCount);
+	for (const auto& worker : _workers)
+	{
+		worker->thread.shutdown();
+	}
+	for (const auto& worker : _workers)
+	{
+		for (auto& jobs : worker->jobs)
+		{
+			for (function<void()>* job : jobs)
+			{
+				delete job;
+			}
+			jobs.clear();
+		}
+	}
+	_workers.clear();
+	std::lock_guard<std::mutex> lock(_finisherMutex);
+	_finishers.clear();
+}
+
+void AsyncThread::run(function<Ref<Values>()> worker, function<void(Values*)> finisher, AsyncPriority priority)
+{
+	AsyncThread::post(new function<void()>([this, worker, finisher]()
+	{
+		Ref<Values> result = worker();
+		AsyncThread::runInMainThread([finisher, result]()
+		{
+			finisher(result);
+		});
+	}), priority);
+}
+
+void AsyncThread::run(function<void()> worker, AsyncPriority priority)
+{
+	AsyncThread::post(new function<void()>(worker), priority);
+}
+
+void AsyncThread::runInMainThread(function<void()> func)
+{
+	std::lock_guard<std::mutex> lock(_finisherMutex);
+	_finishers.push_back(func);
+}
+
+void AsyncThread::post(function<void()>* job, AsyncPriority priority)
+{
+	if (_stopped)
+	{
+		delete job;
+		return;
+	}
+	if (_workers.empty())
+	{
+		for (Uint32 i = 0; i < _workerCount; i++)
+		{
+			auto worker = New<Worker>();
+			worker->owner = this;
+			worker->index = i;
+			_workers.push_back(std::move(worker));
+		}
+		for (const auto& worker : _workers)
+		{
+			worker->thread.init(AsyncThread::work, worker.get());
+		}
+	}
+	if (!_scheduled)
+	{
+		_scheduled = true;
+		SharedDirector.getSystemScheduler()->schedule([this](double deltaTime)
+		{
+			DORA_UNUSED_PARAM(deltaTime);
+			AsyncThread::finish();
+			return false;
+		});
+	}
+	/* jobs posted from a worker stay in its own queues,
+	 others are spread over the workers */
+	Uint32 index = g_currentPool == this ? g_currentWorker : _nextWorker++ % _workerCount;
+	Worker* worker = _workers[index].get();
+	{
+		std::lock_guard<std::mutex> lock(worker->mutex);
+		worker->jobs[s_cast<int>(priority)].push_back(job);
+	}
+	_jobSemaphore.post();
+}
+
+function<void()>* AsyncThread::steal(Uint32 index)
+{
+	/* take the oldest job from the own queues first,
+	 then the newest job from the other workers */
+	for (int priority = 0; priority < 3; priority++)
+	{
+		{
+			Worker* worker = _workers[index].get();
+			std::lock_guard<std::mutex> lock(worker->mutex);
+			auto& jobs = worker->jobs[priority];
+			if (!jobs.empty())
+			{
+				function<void()>* job = jobs.front();
+				jobs.pop_front();
+				return job;
+			}
+		}
+		for (Uint32 i = 1; i < _workerCount; i++)
+		{
+			Worker* victim = _workers[(index + i) % _workerCount].get();
+			std::lock_guard<std::mutex> lock(victim->mutex);
+			auto& jobs = victim->jobs[priority];
+			if (!jobs.empty())
+			{
+				function<void()>* job = jobs.back();
+				jobs.pop_back();
+				return job;
+			}
+		}
+	}
+	return nullptr;
+}
+
+void AsyncThread::finish()
+{
+	vector<function<void()>> finishers;
+	{
+		std::lock_guard<std::mutex> lock(_finisherMutex);
+		finishers.swap(_finishers);
+	}
+	for (const auto& finisher : finishers)
+	{
+		finisher();
+	}
+}
+
+int AsyncThread::work(bx::Thread* thread, void* userData)
+{
+	DORA_UNUSED_PARAM(thread);
+	Worker* worker = r_cast<Worker*>(userData);
+	AsyncThread* pool = worker->owner;
+	g_currentPool = pool;
+	g_currentWorker = worker->index;
+	while (true)
+	{
+		/* each posted job adds one count to the semaphore, so a job
+		 is guaranteed to be found after a successful wait */
+		pool->_jobSemaphore.wait();
+		if (pool->_stopped) break;
+		function<void()>* job = nullptr;
+		while (!(job = pool->steal(worker->index)))
+		{
+			if (pool->_stopped) return 0;
+			std::this_thread::yield();
+		}
+		(*job)();
+		delete job;
+	}
+	return 0;
+}
+
 NS_DOROTHY_END
@@ -9,6 +9,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #pragma once
 
 #include <atomic>
+#include <mutex>
+#include <deque>
 #include "Event/EventQueue.h"
 #include "Support/Value.h"
 
@@ -41,12 +43,32 @@ private:
 	EventQueue _finisherEvent;
 };
 
+enum class AsyncPriority
+{
+	High = 0,
+	Normal = 1,
+	Low = 2
+};
+
+/** @brief a work-stealing thread pool sized to the CPU count.
+ Each worker thread owns job queues for every priority, posted jobs are
+ spread over the workers, a worker runs its own jobs in posting order
+ and steals the newest jobs from the others when idle.
+ Finishers are queued and run in main thread by the system scheduler.
+ Jobs on the pool run concurrently, work that must keep its order
+ like file writes goes to the serial FileIO queue. */
 class AsyncThread
 {
 public:
+	virtual ~AsyncThread();
 	Async FileIO;
-	Async Process;
-	Async Loader;
+	PROPERTY_READONLY(Uint32, WorkerCount);
+	void run(function<Ref<Values>()> worker, function<void(Values*)> finisher, AsyncPriority priority = AsyncPriority::Normal);
+	void run(function<void()> worker, AsyncPriority priority = AsyncPriority::Normal);
+	/** @brief post a function to be run in main thread, thread safe. */
+	void runInMainThread(function<void()> func);
+	void stop();
+	static int work(bx::Thread* thread, void* userData);
 #if BX_PLATFORM_WINDOWS
 	inline void* operator new(size_t i)
 	{
@@ -57,6 +79,28 @@ public:
 		_mm_free(p);
 	}
 #endif // BX_PLATFORM_WINDOWS
+protected:
+	AsyncThread();
+	void post(function<void()>* job, AsyncPriority priority);
+	function<void()>* steal(Uint32 index);
+	void finish();
+private:
+	struct Worker
+	{
+		AsyncThread* owner;
+		Uint32 index;
+		bx::Thread thread;
+		std::mutex mutex;
+		std::deque<function<void()>*> jobs[3];
+	};
+	bool _scheduled;
+	std::atomic_bool _stopped;
+	std::atomic<Uint32> _nextWorker;
+	Uint32 _workerCount;
+	vector<Own<Worker>> _workers;
+	bx::Semaphore _jobSemaphore;
+	std::mutex _finisherMutex;
+	vector<function<void()>> _finishers;
 	SINGLETON_REF(AsyncThread, ObjectBase);
 };
 
@@ -0,0 +1,84 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#include "Const/Header.h"
+#include "Common/FrameArena.h"
+
+NS_DOROTHY_BEGIN
+
+#ifndef DORA_FRAME_ARENA_CAPACITY
+#define DORA_FRAME_ARENA_CAPACITY (256 * 1024) // 256KB
+#endif // DORA_FRAME_ARENA_CAPACITY
+
+FrameArena::FrameArena():
+_buffer(new Uint8[DORA_FRAME_ARENA_CAPACITY], DORA_FRAME_ARENA_CAPACITY),
+_offset(0),
+_extraSize(0),
+_peakSize(0)
+{ }
+
+size_t FrameArena::getCapacity() const
+{
+	return _buffer.size();
+}
+
+size_t FrameArena::getSize() const
+{
+	return _offset + _extraSize;
+}
+
+size_t FrameArena::getPeakSize() const
+{
+	return _peakSize;
+}
+
+void* FrameArena::alloc(size_t size, size_t align)
+{
+	size_t start = (r_cast<uintptr_t>(_buffer.get()) + _offset + align - 1) & ~(align - 1);
+	size_t offset = start - r_cast<uintptr_t>(_buffer.get());
+	if (offset + size <= _buffer.size())
+	{
+		_offset = offset + size;
+		return r_cast<void*>(start);
+	}
+	/* the buffer is full, take an extra chunk for this frame */
+	size_t chunkSize = size + align;
+	_extraChunks.push_back(OwnArray<Uint8>(new Uint8[chunkSize], chunkSize));
+	_extraSize += chunkSize;
+	uintptr_t chunk = r_cast<uintptr_t>(_extraChunks.back().get());
+	return r_cast<void*>((chunk + align - 1) & ~(align - 1));
+}
+
+void FrameArena::free(void* ptr, size_t size)
+{
+	Uint8* addr = r_cast<Uint8*>(ptr);
+	if (addr + size == _buffer.get() + _offset)
+	{
+		_offset = addr - _buffer.get();
+	}
+}
+
+void FrameArena::reset()
+{
+	_peakSize = std::max(_peakSize, getSize());
+	if (!_extraChunks.empty())
+	{
+		/* grow the buffer to hold all the memory used by last frame */
+		size_t capacity = _buffer.size();
+		while (capacity < _offset + _extraSize)
+		{
+			capacity *= 2;
+		}
+		_extraChunks.clear();
+		_buffer = OwnArray<Uint8>(new Uint8[capacity], capacity);
+	}
+	_offset = 0;
+	_extraSize = 0;
+}
+
+NS_DOROTHY_END
@@ -0,0 +1,72 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+NS_DOROTHY_BEGIN
+
+/** @brief A bump allocator for transient memory that lives no longer
+ than the current frame. All the memory is released at once by reset()
+ at the end of Director::mainLoop, so it is only safe to be used in
+ logic thread for data that does not survive the frame.
+ When a frame needs more memory than the capacity, extra chunks are
+ allocated and the buffer grows to fit them in the next frame.
+ */
+class FrameArena
+{
+public:
+	virtual ~FrameArena() { }
+	PROPERTY_READONLY(size_t, Capacity);
+	PROPERTY_READONLY(size_t, Size);
+	PROPERTY_READONLY(size_t, PeakSize);
+	void* alloc(size_t size, size_t align = alignof(std::max_align_t));
+	/** @brief give back memory when it is the latest allocation,
+	 otherwise it stays until reset. */
+	void free(void* ptr, size_t size);
+	void reset();
+protected:
+	FrameArena();
+private:
+	OwnArray<Uint8> _buffer;
+	size_t _offset;
+	size_t _extraSize;
+	size_t _peakSize;
+	vector<OwnArray<Uint8>> _extraChunks;
+	SINGLETON_REF(FrameArena);
+};
+
+#define SharedFrameArena \
+	Dorothy::Singleton<Dorothy::FrameArena>::shared()
+
+/** @brief STL compatible allocator takes memory from frame arena. */
+template <class T>
+class FrameAllocator
+{
+public:
+	typedef T value_type;
+	FrameAllocator() noexcept { }
+	template <class U>
+	FrameAllocator(const FrameAllocator<U>&) noexcept { }
+	T* allocate(size_t n)
+	{
+		return r_cast<T*>(SharedFrameArena.alloc(n * sizeof(T), alignof(T)));
+	}
+	void deallocate(T* ptr, size_t n) noexcept
+	{
+		SharedFrameArena.free(ptr, n * sizeof(T));
+	}
+	template <class U>
+	bool operator==(const FrameAllocator<U>&) const noexcept { return true; }
+	template <class U>
+	bool operator!=(const FrameAllocator<U>&) const noexcept { return false; }
+};
+
+template <class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+NS_DOROTHY_END
@@ -0,0 +1,377 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+#pragma once
+
+#include "Common/Async.h"
+#include <optional>
+
+NS_DOROTHY_BEGIN
+
+template <class T>
+class Task;
+
+template <class T>
+struct TaskOf
+{
+	typedef Task<T> type;
+};
+
+template <class T>
+struct TaskOf<Task<T>>
+{
+	typedef Task<T> type;
+};
+
+/* a void task stores an empty value to be handled as the others */
+template <class T>
+struct TaskValue
+{
+	typedef T type;
+};
+
+template <>
+struct TaskValue<void>
+{
+	typedef std::tuple<> type;
+};
+
+template <class T>
+struct TaskHandler
+{
+	typedef function<void(T&)> type;
+};
+
+template <>
+struct TaskHandler<void>
+{
+	typedef function<void()> type;
+};
+
+template <class Func, class T>
+struct TaskResult
+{
+	typedef std::invoke_result_t<Func, T&> type;
+};
+
+template <class Func>
+struct TaskResult<Func, void>
+{
+	typedef std::invoke_result_t<Func> type;
+};
+
+/** @brief A value that will be ready later. Workers run in the async
+ thread pool while results, continuations and cancellations are always
+ handled in main thread, so chained loading reads like this:
+ @example
+	Task<OwnArray<Uint8>>::run([]() { return loadData(); })
+		.thenAsync([](OwnArray<Uint8>& data) { return decode(data); })
+		.then([](Image* image) { return createTexture(image); });
+ A Task<void> carries no value, its continuations take no argument.
+ */
+template <class T>
+class Task
+{
+public:
+	typedef T ValueType;
+	typedef std::add_lvalue_reference_t<T> Reference;
+	Task():_state(std::make_shared<State>()) { }
+	bool isPending() const
+	{
+		return _state->status == Status::Pending;
+	}
+	bool isDone() const
+	{
+		return _state->status == Status::Done;
+	}
+	bool isCanceled() const
+	{
+		return _state->status == Status::Canceled;
+	}
+	Reference get() const
+	{
+		AssertUnless(isDone(), "can not get value from an unfinished task.");
+		if constexpr (std::is_void<T>::value) return;
+		else return *_state->value;
+	}
+	/** @brief finish the task with a value, must be called in main thread. */
+	void resolve(typename TaskValue<T>::type value) const
+	{
+		if (!isPending()) return;
+		_state->value.emplace(std::move(value));
+		settle(Status::Done);
+	}
+	/** @brief finish a void task, must be called in main thread. */
+	void resolve() const
+	{
+		static_assert(std::is_void<T>::value, "only a void task can be resolved without a value.");
+		resolve(typename TaskValue<T>::type());
+	}
+	/** @brief drop the task and the continuations waiting for it,
+	 pending workers of the task will be skipped. */
+	void cancel() const
+	{
+		if (!isPending()) return;
+		settle(Status::Canceled);
+	}
+	/** @brief run the handler in main thread when the task is done
+	 or canceled, run it at once if the task is already settled. */
+	void onSettled(const function<void()>& handler) const
+	{
+		if (isPending()) _state->handlers.push_back(handler);
+		else handler();
+	}
+	/** @brief continue with a function runs in main thread,
+	 a function returning a task is flattened. */
+	template <class Func>
+	auto then(Func func) const -> typename TaskOf<typename TaskResult<Func, T>::type>::type
+	{
+		typedef typename TaskResult<Func, T>::type Result;
+		typename TaskOf<Result>::type next;
+		auto state = _state;
+		onSettled([state, next, func]() mutable
+		{
+			if (!next.isPending()) return;
+			if (state->status == Status::Canceled)
+			{
+				next.cancel();
+				return;
+			}
+			if constexpr (std::is_void<Result>::value)
+			{
+				Task::invoke(func, *state);
+				next.resolve();
+			}
+			else Task::forward(next, Task::invoke(func, *state));
+		});
+		return next;
+	}
+	/** @brief handle the value in main thread at the end of a chain,
+	 the handler is skipped when the task is canceled. */
+	void done(const typename TaskHandler<T>::type& handler) const
+	{
+		auto state = _state;
+		onSettled([state, handler]()
+		{
+			if (state->status == Status::Done) Task::invoke(handler, *state);
+		});
+	}
+	/** @brief continue with a function runs in the async thread pool. */
+	template <class Func>
+	auto thenAsync(Func func, AsyncPriority priority = AsyncPriority::Normal) const -> Task<typename TaskResult<Func, T>::type>
+	{
+		typedef typename TaskResult<Func, T>::type Result;
+		Task<Result> next;
+		auto state = _state;
+		onSettled([state, next, func, priority]()
+		{
+			if (!next.isPending()) return;
+			if (state->status == Status::Canceled)
+			{
+				next.cancel();
+				return;
+			}
+			next.work([state, func]()
+			{
+				return Task::invoke(func, *state);
+			}, priority);
+		});
+		return next;
+	}
+	/** @brief get a task with a worker runs in the async thread pool. */
+	static Task run(const function<T()>& worker, AsyncPriority priority = AsyncPriority::Normal)
+	{
+		Task task;
+		task.work(worker, priority);
+		return task;
+	}
+	static Task resolved(typename TaskValue<T>::type value)
+	{
+		Task task;
+		task.resolve(std::move(value));
+		return task;
+	}
+	static Task resolved()
+	{
+		Task task;
+		task.resolve();
+		return task;
+	}
+private:
+	enum class Status
+	{
+		Pending,
+		Done,
+		Canceled
+	};
+	struct State
+	{
+		std::atomic<Status> status = {Status::Pending};
+		std::optional<typename TaskValue<T>::type> value;
+		vector<function<void()>> handlers;
+	};
+	template <class Func>
+	static decltype(auto) invoke(Func& func, State& state)
+	{
+		if constexpr (std::is_void<T>::value) return func();
+		else return func(*state.value);
+	}
+	void settle(Status status) const
+	{
+		_state->status = status;
+		vector<function<void()>> handlers;
+		handlers.swap(_state->handlers);
+		for (const auto& handler : handlers)
+		{
+			handler();
+		}
+	}
+	void work(const function<T()>& worker, AsyncPriority priority) const
+	{
+		Task task = *this;
+		SharedAsyncThread.run([task, worker = worker]() mutable
+		{
+			/* the value is only read in main thread after the task
+			 is settled there, so it is safe to be assigned here */
+			if (task.isPending())
+			{
+				if constexpr (std::is_void<T>::value)
+				{
+					worker();
+					task._state->value.emplace();
+				}
+				else task._state->value.emplace(worker());
+			}
+			/* hand the task and the worker captures back to main thread,
+			 so the last references to the states are released there */
+			SharedAsyncThread.runInMainThread([task = std::move(task), worker = std::move(worker)]()
+			{
+				if (task.isPending()) task.settle(Status::Done);
+			});
+			task._state = nullptr;
+			worker = nullptr;
+		}, priority);
+	}
+	template <class U>
+	static void forward(const Task<U>& next, U value)
+	{
+		next.resolve(std::move(value));
+	}
+	template <class U>
+	static void forward(const Task<U>& next, const Task<U>& task)
+	{
+		task.onSettled([next, task]()
+		{
+			if (task.isCanceled()) next.cancel();
+			else if constexpr (std::is_void<U>::value) next.resolve();
+			else if constexpr (std::is_copy_constructible<U>::value) next.resolve(task.get());
+			else next.resolve(std::move(task.get()));
+		});
+	}
+	std::shared_ptr<State> _state;
+	template <class U>
+	friend class Task;
+};
+
+/** @brief get a task done when all the tasks are done,
+ canceled when any of them is canceled and vice versa. */
+template <class T>
+Task<vector<T>> whenAll(const vector<Task<T>>& tasks)
+{
+	Task<vector<T>> result;
+	if (tasks.empty())
+	{
+		result.resolve(vector<T>());
+		return result;
+	}
+	auto remaining = std::make_shared<size_t>(tasks.size());
+	for (const auto& task : tasks)
+	{
+		task.onSettled([tasks, result, remaining, task]()
+		{
+			if (!result.isPending()) return;
+			if (task.isCanceled())
+			{
+				result.cancel();
+				return;
+			}
+			if (--*remaining == 0)
+			{
+				vector<T> values;
+				values.reserve(tasks.size());
+				for (const auto& item : tasks)
+				{
+					values.push_back(item.get());
+				}
+				result.resolve(std::move(values));
+			}
+		});
+	}
+	result.onSettled([result, tasks]()
+	{
+		if (!result.isCanceled()) return;
+		for (const auto& task : tasks)
+		{
+			task.cancel();
+		}
+	});
+	return result;
+}
+
+inline Task<void> whenAll(const vector<Task<void>>& tasks)
+{
+	Task<void> result;
+	auto remaining = std::make_shared<size_t>(tasks.size());
+	if (tasks.empty()) result.resolve();
+	for (const auto& task : tasks)
+	{
+		task.onSettled([result, remaining, task]()
+		{
+			if (!result.isPending()) return;
+			if (task.isCanceled()) result.cancel();
+			else if (--*remaining == 0) result.resolve();
+		});
+	}
+	result.onSettled([result, tasks]()
+	{
+		if (!result.isCanceled()) return;
+		for (const auto& task : tasks)
+		{
+			task.cancel();
+		}
+	});
+	return result;
+}
+
+template <class... Ts>
+Task<std::tuple<Ts...>> whenAll(const Task<Ts>&... tasks)
+{
+	Task<std::tuple<Ts...>> result;
+	auto remaining = std::make_shared<size_t>(sizeof...(Ts));
+	auto check = [result, remaining, tasks...]()
+	{
+		if (!result.isPending()) return;
+		if ((tasks.isCanceled() || ...))
+		{
+			result.cancel();
+			return;
+		}
+		if (--*remaining == 0)
+		{
+			result.resolve(std::make_tuple(tasks.get()...));
+		}
+	};
+	(tasks.onSettled(check), ...);
+	result.onSettled([result, tasks...]()
+	{
+		if (result.isCanceled()) (tasks.cancel(), ...);
+	});
+	return result;
+}
+
+NS_DOROTHY_END
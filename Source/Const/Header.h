@@ -37,6 +37,15 @@ using std::tuple;
 #include "bx/semaphore.h"
 #include "bx/math.h"
 #include "SDL_syswm.h"
+#if BX_PLATFORM_LINUX
+// X11 headers define macros clashing with engine names
+#undef None
+#undef Status
+#undef Bool
+#undef Always
+#undef Success
+#undef Complex
+#endif // BX_PLATFORM_LINUX
 #include "SDL.h"
 #include "PlayRho/PlayRho.hpp"
 #include "Other/AcfDelegate.h"
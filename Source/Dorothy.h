@@ -20,13 +20,16 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Basic/Application.h"
 #include "Basic/Director.h"
 #include "Basic/Scheduler.h"
+#include "Basic/FrameProfiler.h"
 #include "Common/Async.h"
+#include "Common/FrameArena.h"
 #include "Support/Array.h"
 #include "Support/Dictionary.h"
 #include "Support/Common.h"
 #include "Input/TouchDispather.h"
 #include "Node/Node.h"
 #include "Cache/TextureCache.h"
+#include "Cache/TextureAtlas.h"
 #include "Basic/View.h"
 #include "Basic/Camera.h"
 #include "Cache/ShaderCache.h"
@@ -42,10 +45,13 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Node/RenderTarget.h"
 #include "Node/ClipNode.h"
 #include "Node/DrawNode.h"
+#include "Node/Prefab.h"
+#include "Node/NodePool.h"
 #include "Node/VGNode.h"
 #include "Cache/ClipCache.h"
 #include "Cache/FrameCache.h"
 #include "Animation/Action.h"
+#include "Animation/Tween.h"
 #include "Animation/ModelDef.h"
 #include "Node/Model.h"
 #include "Cache/ModelCache.h"
@@ -65,20 +65,31 @@ bgfx::ProgramHandle Effect::apply()
 	return _program;
 }
 
+bgfx::ProgramHandle Effect::getWorldProgram() const
+{
+	return _worldProgram;
+}
+
 Effect::Effect(Shader* vertShader, Shader* fragShader):
 _program(BGFX_INVALID_HANDLE),
+_worldProgram(BGFX_INVALID_HANDLE),
 _vertShader(vertShader),
 _fragShader(fragShader)
 { }
 
 Effect::Effect(String vertShader, String fragShader):
 _program(BGFX_INVALID_HANDLE),
+_worldProgram(BGFX_INVALID_HANDLE),
 _vertShader(SharedShaderCache.load(vertShader)),
 _fragShader(SharedShaderCache.load(fragShader))
 { }
 
 Effect::~Effect()
 {
+	if (bgfx::isValid(_worldProgram) && _worldProgram.idx != _program.idx)
+	{
+		bgfx::destroy(_worldProgram);
+	}
 	if (bgfx::isValid(_program))
 	{
 		bgfx::destroy(_program);
@@ -89,7 +100,22 @@ bool Effect::init()
 {
 	if (!Object::init()) return false;
 	_program = bgfx::createProgram(_vertShader->getHandle(), _fragShader->getHandle());
-	return bgfx::isValid(_program);
+	if (!bgfx::isValid(_program)) return false;
+	/* the builtin pass-through vertex shaders share their inputs and outputs
+	 with vs_spritemodel, so the same fragment shader can be paired with it
+	 to have the view projection applied on GPU */
+	Shader* modelShader = SharedShaderCache.load("builtin::vs_spritemodel"_slice);
+	if (_vertShader == modelShader)
+	{
+		_worldProgram = _program;
+	}
+	else if (_vertShader == SharedShaderCache.load("builtin::vs_sprite"_slice) ||
+		_vertShader == SharedShaderCache.load("builtin::vs_draw"_slice))
+	{
+		_worldVertShader = modelShader;
+		_worldProgram = bgfx::createProgram(modelShader->getHandle(), _fragShader->getHandle());
+	}
+	return true;
 }
 
 void Effect::set(String name, float var)
@@ -25,6 +25,9 @@ public:
 	void set(String name, const Vec4& var);
 	void set(String name, const Matrix& var);
 	Value* get(String name) const;
+	/** @brief program variant reading world space vertices and transforming them
+	 by u_modelViewProj, invalid when the vertex shader has no such variant. */
+	PROPERTY_READONLY(bgfx::ProgramHandle, WorldProgram);
 	bgfx::ProgramHandle apply();
 	CREATE_FUNC(Effect);
 protected:
@@ -47,7 +50,9 @@ private:
 	};
 	Ref<Shader> _fragShader;
 	Ref<Shader> _vertShader;
+	Ref<Shader> _worldVertShader;
 	bgfx::ProgramHandle _program;
+	bgfx::ProgramHandle _worldProgram;
 	unordered_map<string, Ref<Uniform>> _uniforms;
 	DORA_TYPE_OVERRIDE(Effect);
 };
@@ -13,55 +13,105 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 NS_DOROTHY_BEGIN
 
-unordered_map<string, Own<EventType>> Event::_eventMap;
+unordered_map<std::size_t, Uint32> Event::_eventIds;
+vector<Own<string>> Event::_eventNames;
+vector<Own<EventType>> Event::_eventTypes;
+
+const Uint32 Event::InvalidId = UINT32_MAX;
 
 Event::Event(String name):
+_id(Event::find(name)),
 _name(name)
 { }
 
+Event::Event(Uint32 id):
+_id(id),
+_name(Event::getName(id))
+{ }
+
 Event::~Event()
 { }
 
-void Event::clear()
+Uint32 Event::intern(String name)
 {
-	_eventMap.clear();
+	/* names are keyed by their Switch hashes, probe the next
+	 hash value on collision to keep lookups free of string allocation */
+	for (std::size_t hash = Switch::hash(name);; hash++)
+	{
+		auto it = _eventIds.find(hash);
+		if (it == _eventIds.end())
+		{
+			Uint32 id = s_cast<Uint32>(_eventNames.size());
+			_eventNames.push_back(New<string>(name.toString()));
+			_eventIds[hash] = id;
+			return id;
+		}
+		if (name == *_eventNames[it->second])
+		{
+			return it->second;
+		}
+	}
 }
 
-void Event::unreg(Listener* listener)
+Uint32 Event::find(String name)
 {
-	auto it = _eventMap.find(listener->getName());
-	if (it != _eventMap.end())
+	for (std::size_t hash = Switch::hash(name);; hash++)
 	{
-		EventType* type = it->second;
-		type->remove(listener);
-		if (type->isEmpty())
+		auto it = _eventIds.find(hash);
+		if (it == _eventIds.end())
 		{
-			_eventMap.erase(it);
+			return Event::InvalidId;
 		}
+		if (name == *_eventNames[it->second])
+		{
+			return it->second;
+		}
+	}
+}
+
+const string& Event::getName(Uint32 id)
+{
+	AssertUnless(id < _eventNames.size(), "invalid event id {}.", id);
+	return *_eventNames[id];
+}
+
+void Event::clear()
+{
+	_eventTypes.clear();
+}
+
+void Event::unreg(Listener* listener)
+{
+	Uint32 id = listener->getId();
+	if (id < _eventTypes.size() && _eventTypes[id])
+	{
+		_eventTypes[id]->remove(listener);
 	}
 }
 
 void Event::reg(Listener* listener)
 {
-	auto it = _eventMap.find(listener->getName());
-	if (it != _eventMap.end())
+	Uint32 id = listener->getId();
+	if (id >= _eventTypes.size())
 	{
-		it->second->add(listener);
+		_eventTypes.resize(_eventNames.size());
 	}
-	else
+	if (!_eventTypes[id])
 	{
-		EventType* type = new EventType(listener->getName());
-		_eventMap[listener->getName()] = MakeOwn(type);
-		type->add(listener);
+		_eventTypes[id] = New<EventType>(listener->getName());
 	}
+	_eventTypes[id]->add(listener);
 }
 
 void Event::send(Event* e)
 {
-	auto it = _eventMap.find(e->getName());
-	if (it != _eventMap.end())
+	if (e->_id < _eventTypes.size())
 	{
-		it->second->handle(e);
+		EventType* type = _eventTypes[e->_id];
+		if (type && !type->isEmpty())
+		{
+			type->handle(e);
+		}
 	}
 }
 
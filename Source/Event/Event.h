@@ -33,21 +33,42 @@ typedef Delegate<void (Event* event)> EventHandler;
  // Send event with all types of arguments, then the callback function will be invoked.
  Event::send("UserEvent", Slice("info1"));
  Event::send("UserEvent", Slice("msg2"));
+
+ // Event names are interned to dense ids, cache the id to skip name lookups for hot events.
+ static const Uint32 userEvent = Event::intern("UserEvent");
+ Event::send(userEvent, Slice("msg3"));
  */
 class Event
 {
 public:
 	virtual ~Event();
 	Event(String name);
+	Event(Uint32 id);
 	inline String getName() const { return _name; }
+	inline Uint32 getId() const { return _id; }
 	virtual int pushArgsToLua() { return 0; }
 public:
 	static Listener* addListener(String name, const EventHandler& handler);
 	static void clear();
 
+	/** @brief Get the dense id of an event name, registering it on first use.
+	 Ids are never recycled and stay valid for the lifetime of the application.
+	 Only called when something starts listening to a name, or for names fixed in code.
+	*/
+	static Uint32 intern(String name);
+	/** @brief Get the id of an interned event name without registering it,
+	 returns Event::InvalidId for names nothing has listened to.
+	*/
+	static Uint32 find(String name);
+	static const Uint32 InvalidId;
+	static const string& getName(Uint32 id);
+
 	template<class... Args>
 	static void send(String name, const Args&... args);
 
+	template<class... Args>
+	static void send(Uint32 id, const Args&... args);
+
 	template<class... Args>
 	static void sendInternal(String name, const Args&... args);
 
@@ -59,9 +80,12 @@ protected:
 	static void reg(Listener* listener);
 	static void unreg(Listener* listener);
 	static void send(Event* event);
+	Uint32 _id;
 	Slice _name;
 private:
-	static unordered_map<string, Own<EventType>> _eventMap;
+	static unordered_map<std::size_t, Uint32> _eventIds;
+	static vector<Own<string>> _eventNames;
+	static vector<Own<EventType>> _eventTypes;
 	friend class Listener;
 	DORA_TYPE_BASE(Event);
 };
@@ -74,6 +98,10 @@ public:
 	Event(name),
 	arguments(std::make_tuple(args...))
 	{ }
+	EventArgs(Uint32 id, const Fields&... args):
+	Event(id),
+	arguments(std::make_tuple(args...))
+	{ }
 	virtual int pushArgsToLua() override
 	{
 		return Tuple::foreach(arguments, LuaArgsPusher());
@@ -101,6 +129,13 @@ void Event::send(String name, const Args&... args)
 	Event::send(&event);
 }
 
+template<class... Args>
+void Event::send(Uint32 id, const Args&... args)
+{
+	EventArgs<Args...> event(id, args...);
+	Event::send(&event);
+}
+
 template<class... Args>
 void Event::get(Args&... args)
 {
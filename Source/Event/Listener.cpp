@@ -60,6 +60,7 @@ void Listener::handle( Event* e )
 }
 
 Listener::Listener( const string& name, const EventHandler& handler ):
+_id(Event::intern(name)),
 _name(name),
 _handler(handler),
 _enabled(false)
@@ -70,6 +71,11 @@ const string& Listener::getName() const
 	return _name;
 }
 
+Uint32 Listener::getId() const
+{
+	return _id;
+}
+
 Listener::~Listener()
 {
 	Listener::setEnabled(false);
@@ -22,6 +22,7 @@ public:
 	PROPERTY_BOOL(Enabled);
 	PROPERTY_REF(EventHandler, Handler);
 	PROPERTY_READONLY_REF(string, Name);
+	PROPERTY_READONLY(Uint32, Id);
 	virtual ~Listener();
 	virtual bool init() override;
 	void clearHandler();
@@ -31,6 +32,7 @@ protected:
 	Listener(const string& name, const EventHandler& handler);
 private:
 	bool _enabled;
+	Uint32 _id;
 	string _name;
 	EventHandler _handler;
 	friend class EventType;
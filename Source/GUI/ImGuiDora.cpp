@@ -265,7 +265,7 @@ void ImGuiDora::loadFontTTF(String ttfFontFile, float fontSize, String glyphRang
 	if (targetGlyphRanges)
 	{
 		_fonts->AddFontFromMemoryTTF(fileData, s_cast<int>(size), s_cast<float>(fontSize), &fontConfig, targetGlyphRanges);
-		SharedAsyncThread.Process.run([this]()
+		SharedAsyncThread.run([this]()
 		{
 			_fonts->Build();
 			return Values::None;
@@ -277,7 +277,7 @@ void ImGuiDora::loadFontTTF(String ttfFontFile, float fontSize, String glyphRang
 			updateTexture(_fonts->TexPixelsAlpha8, _fonts->TexWidth, _fonts->TexHeight);
 			MakeOwnArray(fileData, s_cast<size_t>(size));
 			isLoadingFont = false;
-		});
+		}, AsyncPriority::Low);
 	}
 	else
 	{
@@ -317,12 +317,15 @@ void ImGuiDora::showStats()
 	ImGui::SameLine();
 	ImGui::Text("%d", stats->numDraw);
 	static int frames = 0;
-	static double cpuTime = 0, gpuTime = 0, deltaTime = 0;
+	static double cpuTime = 0, gpuTime = 0, deltaTime = 0, jitter = 0, maxJitter = 0;
 	cpuTime += SharedApplication.getCPUTime();
+	jitter += SharedApplication.getFrameJitter();
+	maxJitter = std::max(maxJitter, SharedApplication.getFrameJitter());
 	gpuTime += std::abs(double(stats->gpuTimeEnd) - double(stats->gpuTimeBegin)) / double(stats->gpuTimerFreq);
 	deltaTime += SharedApplication.getDeltaTime();
 	frames++;
 	static double lastCpuTime = 0, lastGpuTime = 0, lastDeltaTime = 1000.0 / SharedApplication.getMaxFPS();
+	static double lastJitter = 0, lastMaxJitter = 0;
 	ImGui::TextColored(Color(0xff00ffff).toVec4(), "CPU time:");
 	ImGui::SameLine();
 	if (lastCpuTime == 0) ImGui::Text("-");
@@ -334,13 +337,21 @@ void ImGuiDora::showStats()
 	ImGui::TextColored(Color(0xff00ffff).toVec4(), "Delta time:");
 	ImGui::SameLine();
 	ImGui::Text("%.1f ms", lastDeltaTime);
+	if (SharedApplication.isFPSLimited())
+	{
+		ImGui::TextColored(Color(0xff00ffff).toVec4(), "Jitter:");
+		ImGui::SameLine();
+		ImGui::Text("%.2f ms (max %.2f ms)", lastJitter, lastMaxJitter);
+	}
 	if (frames == SharedApplication.getMaxFPS())
 	{
 		lastCpuTime = 1000.0 * cpuTime / frames;
 		lastGpuTime = 1000.0 * gpuTime / frames;
 		lastDeltaTime = 1000.0 * deltaTime / frames;
+		lastJitter = 1000.0 * jitter / frames;
+		lastMaxJitter = 1000.0 * maxJitter;
 		frames = 0;
-		cpuTime = gpuTime = deltaTime = 0.0;
+		cpuTime = gpuTime = deltaTime = jitter = maxJitter = 0.0;
 	}
 	ImGui::TextColored(Color(0xff00ffff).toVec4(), "C++ Object:");
 	ImGui::SameLine();
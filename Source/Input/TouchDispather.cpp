@@ -18,7 +18,7 @@ NS_DOROTHY_BEGIN
 /* Touch */
 
 Uint32 Touch::_source =
-#if BX_PLATFORM_OSX
+#if BX_PLATFORM_OSX || BX_PLATFORM_LINUX
 	Touch::FromMouse;
 #elif BX_PLATFORM_IOS || BX_PLATFORM_ANDROID
 	Touch::FromTouch;
@@ -245,7 +245,7 @@ Vec2 NodeTouchHandler::getPos(const Vec3& winPos)
 	return Vec2{-1.0f, -1.0f};
 }
 
-Vec2 NodeTouchHandler::getPos(const SDL_Event& event)
+static Vec3 getWinPos(const SDL_Event& event)
 {
 	Vec3 pos{-1.0f, -1.0f, 0.0f};
 	switch (event.type)
@@ -277,7 +277,12 @@ Vec2 NodeTouchHandler::getPos(const SDL_Event& event)
 			break;
 		}
 	}
-	return getPos(pos);
+	return pos;
+}
+
+Vec2 NodeTouchHandler::getPos(const SDL_Event& event)
+{
+	return getPos(getWinPos(event));
 }
 
 bool NodeTouchHandler::down(const SDL_Event& event)
@@ -570,19 +575,175 @@ void TouchDispatcher::add(const SDL_Event& event)
 
 void TouchDispatcher::add(TouchHandler* handler)
 {
-	_handlers.push_back(handler);
+	_handlers.emplace_back(handler, nullptr);
+}
+
+void TouchDispatcher::add(Node* root)
+{
+	updateTouchNodes();
+	auto it = _rootTouchNodes.find(root);
+	if (it != _rootTouchNodes.end())
+	{
+		for (Node* node : it->second)
+		{
+			_handlers.emplace_back(node->getTouchHandler(), node);
+		}
+	}
+}
+
+void TouchDispatcher::addTouchNode(Node* node)
+{
+	if (_touchNodes.insert(node).second)
+	{
+		_touchNodesDirty = true;
+	}
+}
+
+void TouchDispatcher::removeTouchNode(Node* node)
+{
+	if (_touchNodes.erase(node) > 0)
+	{
+		_touchNodesDirty = true;
+	}
+}
+
+void TouchDispatcher::markTouchNodesDirty()
+{
+	if (!_touchNodes.empty())
+	{
+		_touchNodesDirty = true;
+	}
+}
+
+void TouchDispatcher::updateTouchNodes()
+{
+	if (!_touchNodesDirty) return;
+	_touchNodesDirty = false;
+	_rootTouchNodes.clear();
+	/* sort nodes by their child index paths from root
+	 to get the same order as the node tree traversal */
+	struct Item
+	{
+		Node* root;
+		Node* node;
+		vector<int> path;
+	};
+	vector<Item> items;
+	items.reserve(_touchNodes.size());
+	for (Node* node : _touchNodes)
+	{
+		if (!node->isVisible()) continue;
+		Item item{nullptr, node, {}};
+		Node* current = node;
+		while (Node* parent = current->getParent())
+		{
+			if (!parent->isVisible() || parent->_flags.isOff(Node::TraverseEnabled))
+			{
+				current = nullptr;
+				break;
+			}
+			/* child indices are refreshed by the lazy sort of reordered children */
+			parent->sortAllChildren();
+			item.path.push_back(s_cast<int>(current->_childIndex));
+			current = parent;
+		}
+		if (current)
+		{
+			item.root = current;
+			std::reverse(item.path.begin(), item.path.end());
+			items.push_back(std::move(item));
+		}
+	}
+	std::sort(items.begin(), items.end(), [](const Item& a, const Item& b)
+	{
+		if (a.root != b.root) return a.root < b.root;
+		return a.path < b.path;
+	});
+	for (const auto& item : items)
+	{
+		_rootTouchNodes[item.root].push_back(item.node);
+	}
+}
+
+bool TouchDispatcher::hitTest(size_t index, const Vec2& winPos)
+{
+	Node* target = _handlers[index].second;
+	if (!target || target->getSize() == Size::zero)
+	{
+		return true;
+	}
+	if (_handlerBounds.empty())
+	{
+		/* project the bounds of the node targets to window space once
+		 for all the touch down events being dispatched this round */
+		Size viewSize = SharedView.getSize();
+		const Matrix& viewProj = SharedDirector.getViewProjection();
+		_handlerBounds.resize(_handlers.size());
+		for (size_t i = 0; i < _handlers.size(); i++)
+		{
+			Node* node = _handlers[i].second;
+			Rect& bounds = _handlerBounds[i];
+			if (!node || node->getSize() == Size::zero)
+			{
+				bounds = Rect::zero;
+				continue;
+			}
+			Matrix MVP;
+			bx::mtxMul(MVP, node->getWorld(), viewProj);
+			const Size& size = node->getSize();
+			Vec2 corners[] = {
+				{0.0f, 0.0f}, {size.width, 0.0f},
+				{0.0f, size.height}, {size.width, size.height}
+			};
+			Vec2 lower{FLT_MAX, FLT_MAX};
+			Vec2 upper{-FLT_MAX, -FLT_MAX};
+			for (const auto& corner : corners)
+			{
+				float in[4] = {corner.x, corner.y, 0.0f, 1.0f};
+				float out[4];
+				bx::vec4MulMtx(out, in, MVP);
+				if (out[3] <= FLT_EPSILON)
+				{
+					/* corner behind the camera, test every touch */
+					lower = {-FLT_MAX, -FLT_MAX};
+					upper = {FLT_MAX, FLT_MAX};
+					break;
+				}
+				Vec2 pos{
+					(out[0] / out[3] + 1.0f) * 0.5f * viewSize.width,
+					(out[1] / out[3] + 1.0f) * 0.5f * viewSize.height
+				};
+				lower = {std::min(lower.x, pos.x), std::min(lower.y, pos.y)};
+				upper = {std::max(upper.x, pos.x), std::max(upper.y, pos.y)};
+			}
+			bounds = Rect(lower.x - 1.0f, lower.y - 1.0f, upper.x - lower.x + 2.0f, upper.y - lower.y + 2.0f);
+		}
+	}
+	const Rect& bounds = _handlerBounds[index];
+	return bounds.size == Size::zero || bounds.containsPoint(winPos);
 }
 
 void TouchDispatcher::dispatch()
 {
 	if (!_events.empty() && !_handlers.empty())
 	{
-		for (auto it  = _handlers.rbegin(); it != _handlers.rend(); ++it)
+		for (size_t index = _handlers.size(); index > 0; index--)
 		{
-			TouchHandler* handler = *it;
+			TouchHandler* handler = _handlers[index - 1].first;
 			for (auto eit = _events.begin(); eit != _events.end();)
 			{
-				if (handler->handle(*eit))
+				bool skip = false;
+				switch (eit->type)
+				{
+					case SDL_MOUSEBUTTONDOWN:
+					case SDL_FINGERDOWN:
+					{
+						Vec3 winPos = getWinPos(*eit);
+						skip = !hitTest(index - 1, Vec2{winPos.x, winPos.y});
+						break;
+					}
+				}
+				if (!skip && handler->handle(*eit))
 				{
 					eit = _events.erase(eit);
 				}
@@ -603,6 +764,7 @@ void TouchDispatcher::dispatch()
 void TouchDispatcher::clearHandlers()
 {
 	_handlers.clear();
+	_handlerBounds.clear();
 }
 
 void TouchDispatcher::clearEvents()
@@ -118,14 +118,27 @@ class TouchDispatcher
 public:
 	void add(const SDL_Event& event);
 	void add(TouchHandler* handler);
+	/** @brief add handlers of the touch enabled nodes under the root node in traversal order. */
+	void add(Node* root);
 	void dispatch();
 	void clearHandlers();
 	void clearEvents();
+	/** @brief called by running nodes when their touch enabled state changes. */
+	void addTouchNode(Node* node);
+	void removeTouchNode(Node* node);
+	/** @brief called when node visibility or children order changes. */
+	void markTouchNodesDirty();
 protected:
-	TouchDispatcher() { }
+	TouchDispatcher():_touchNodesDirty(false) { }
+	void updateTouchNodes();
+	bool hitTest(size_t index, const Vec2& winPos);
 private:
-	vector<TouchHandler*> _handlers;
+	bool _touchNodesDirty;
+	vector<std::pair<TouchHandler*, Node*>> _handlers;
+	vector<Rect> _handlerBounds;
 	list<SDL_Event> _events;
+	unordered_set<Node*> _touchNodes;
+	unordered_map<Node*, vector<Node*>> _rootTouchNodes;
 	SINGLETON_REF(TouchDispatcher, Director);
 };
 
@@ -286,6 +286,22 @@ bool Node_eachChild(Node* self, const LuaFunction<bool>& func)
 	});
 }
 
+void Node_tween(Node* self, String name, float duration, float start, float stop, Ease::Enum easing)
+{
+	Property::Enum prop = Property::fromName(name);
+	if (prop == Property::None)
+	{
+		Error("tween with unsupported property \"{}\".", name);
+		return;
+	}
+	self->tween(prop, duration, start, stop, easing);
+}
+
+bool Node_stopTween(Node* self, String name)
+{
+	return self->stopTween(Property::fromName(name));
+}
+
 bool Cache::load(String filename)
 {
 	string ext = filename.getFileExtension();
@@ -517,6 +533,11 @@ void Cache::removeUnused(String name)
 	}
 }
 
+void Cache::setTextureAtlasEnabled(bool var)
+{
+	SharedTextureCache.setAtlasEnabled(var);
+}
+
 Sprite* Sprite_create(String clipStr)
 {
 	return SharedClipCache.loadSprite(clipStr);
@@ -659,25 +680,7 @@ namespace LuaAction
 							float start = toNumber(L, location, 3);
 							float stop = toNumber(L, location, 4);
 							Ease::Enum ease = s_cast<Ease::Enum>(s_cast<int>(toNumber(L, location, 5, true)));
-							Property::Enum prop = Property::None;
-							switch (nameHash)
-							{
-								case "X"_hash: prop = Property::X; break;
-								case "Y"_hash: prop = Property::Y; break;
-								case "Z"_hash: prop = Property::Z; break;
-								case "ScaleX"_hash: prop = Property::ScaleX; break;
-								case "ScaleY"_hash: prop = Property::ScaleY; break;
-								case "SkewX"_hash: prop = Property::SkewX; break;
-								case "SkewY"_hash: prop = Property::SkewY; break;
-								case "Angle"_hash: prop = Property::Angle; break;
-								case "AngleX"_hash: prop = Property::AngleX; break;
-								case "AngleY"_hash: prop = Property::AngleY; break;
-								case "Width"_hash: prop = Property::Width; break;
-								case "Height"_hash: prop = Property::Height; break;
-								case "AnchorX"_hash: prop = Property::AnchorX; break;
-								case "AnchorY"_hash: prop = Property::AnchorY; break;
-								case "Opacity"_hash: prop = Property::Opacity; break;
-							}
+							Property::Enum prop = Property::fromName(name);
 							return PropertyAction::alloc(duration, start, stop, prop, ease);
 						}
 						case "Roll"_hash:
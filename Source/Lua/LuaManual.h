@@ -36,6 +36,9 @@ inline Director* Director_shared() { return &SharedDirector; }
 /* View */
 inline View* View_shared() { return &SharedView; }
 
+/* FrameProfiler */
+inline FrameProfiler* FrameProfiler_shared() { return &SharedFrameProfiler; }
+
 /* Log */
 inline void Dora_Log(String msg) { Info("{}", msg); }
 
@@ -44,6 +47,8 @@ int Node_emit(lua_State* L);
 int Node_slot(lua_State* L);
 int Node_gslot(lua_State* L);
 bool Node_eachChild(Node* self, const LuaFunction<bool>& func);
+void Node_tween(Node* self, String name, float duration, float start, float stop, Ease::Enum easing = Ease::Linear);
+bool Node_stopTween(Node* self, String name);
 
 /* Cache */
 struct Cache
@@ -56,6 +61,7 @@ struct Cache
 	static bool unload(String name);
 	static void removeUnused();
 	static void removeUnused(String type);
+	static void setTextureAtlasEnabled(bool var);
 };
 
 /* Sprite */
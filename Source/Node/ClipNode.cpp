@@ -27,6 +27,19 @@ _stencil(stencil)
 ClipNode::~ClipNode()
 { }
 
+Node* ClipNode::cloneSelf()
+{
+	Node* stencil = nullptr;
+	if (_stencil)
+	{
+		stencil = _stencil->clone();
+		if (!stencil) return nullptr;
+	}
+	ClipNode* node = ClipNode::create(stencil);
+	node->_alphaThreshold = _alphaThreshold;
+	return node;
+}
+
 void ClipNode::setStencil(Node* var)
 {
 	AssertIf(var && var->getParent(), "stencil node already added. It can't be added again.");
@@ -109,6 +122,12 @@ void ClipNode::cleanup()
 	}
 }
 
+bool ClipNode::reviveSelf()
+{
+	/* the stencil is not a child, so it is revived here */
+	return !_stencil || _stencil->revive();
+}
+
 void ClipNode::drawFullScreenStencil(Uint8 maskLayer, bool value)
 {
 	SharedRendererManager.flush();
@@ -31,6 +31,8 @@ protected:
 	void drawFullScreenStencil(Uint8 maskLayer, bool value);
 	void drawStencil(Uint8 maskLayer, bool value);
 	void setupAlphaTest();
+	virtual Node* cloneSelf() override;
+	virtual bool reviveSelf() override;
 private:
 	float _alphaThreshold;
 	Ref<Node> _stencil;
@@ -21,6 +21,9 @@ NS_DOROTHY_BEGIN
 bgfx::VertexDecl DrawVertex::ms_decl;
 DrawVertex::Init DrawVertex::init;
 
+bgfx::VertexDecl DrawVertex2D::ms_decl;
+DrawVertex2D::Init DrawVertex2D::init;
+
 DrawNode::DrawNode():
 _renderState(BGFX_STATE_NONE),
 _blendFunc(BlendFunc::Default)
@@ -73,13 +76,40 @@ void DrawNode::updateRealOpacity()
 	_flags.setOn(DrawNode::VertexColorDirty);
 }
 
-const Matrix& DrawNode::getWorld()
+void DrawNode::onWorldChanged()
+{
+	_flags.setOn(DrawNode::VertexPosDirty);
+}
+
+template <typename PosColors>
+static Rect getPosColorBounds(const PosColors& posColors)
 {
-	if (_flags.isOn(Node::WorldDirty))
+	if (posColors.empty()) return Rect::zero;
+	Vec2 lower{FLT_MAX, FLT_MAX};
+	Vec2 upper{-FLT_MAX, -FLT_MAX};
+	for (const auto& posColor : posColors)
 	{
-		_flags.setOn(DrawNode::VertexPosDirty);
+		lower = {std::min(lower.x, posColor.pos.x), std::min(lower.y, posColor.pos.y)};
+		upper = {std::max(upper.x, posColor.pos.x), std::max(upper.y, posColor.pos.y)};
 	}
-	return Node::getWorld();
+	return Rect(lower, Size{upper.x - lower.x, upper.y - lower.y});
+}
+
+Node* DrawNode::cloneSelf()
+{
+	DrawNode* node = DrawNode::create();
+	node->_renderState = _renderState;
+	node->_blendFunc = _blendFunc;
+	node->_vertices = _vertices;
+	node->_posColors = _posColors;
+	node->_indices = _indices;
+	return node;
+}
+
+bool DrawNode::getContentBounds(Rect& bounds)
+{
+	bounds = getPosColorBounds(_posColors);
+	return true;
 }
 
 void DrawNode::render()
@@ -106,8 +136,7 @@ void DrawNode::render()
 	if (_flags.isOn(DrawNode::VertexPosDirty))
 	{
 		_flags.setOff(DrawNode::VertexPosDirty);
-		Matrix transform;
-		bx::mtxMul(transform, _world, SharedDirector.getViewProjection());
+		const Matrix& transform = getWorld();
 		for (size_t i = 0; i < _vertices.size(); i++)
 		{
 			bx::vec4MulMtx(&_vertices[i].x, &_posColors[i].pos.x, transform);
@@ -155,6 +184,7 @@ void DrawNode::drawDot(const Vec2& pos, float radius, Color color)
 
 	_flags.setOn(DrawNode::VertexColorDirty);
 	_flags.setOn(DrawNode::VertexPosDirty);
+	markBoundsDirty();
 }
 
 void DrawNode::drawSegment(const Vec2& from, const Vec2& to, float radius, Color color)
@@ -216,6 +246,7 @@ void DrawNode::drawSegment(const Vec2& from, const Vec2& to, float radius, Color
 
 	_flags.setOn(DrawNode::VertexColorDirty);
 	_flags.setOn(DrawNode::VertexPosDirty);
+	markBoundsDirty();
 }
 
 void DrawNode::drawPolygon(const vector<Vec2>& verts, Color fillColor, float borderWidth, Color borderColor)
@@ -315,6 +346,7 @@ void DrawNode::drawPolygon(const Vec2* verts, Uint32 count, Color fillColor, flo
 
 	_flags.setOn(DrawNode::VertexColorDirty);
 	_flags.setOn(DrawNode::VertexPosDirty);
+	markBoundsDirty();
 }
 
 void DrawNode::drawVertices(const VertexColor* verts, Uint32 count)
@@ -343,6 +375,7 @@ void DrawNode::drawVertices(const VertexColor* verts, Uint32 count)
 
 	_flags.setOn(DrawNode::VertexColorDirty);
 	_flags.setOn(DrawNode::VertexPosDirty);
+	markBoundsDirty();
 }
 
 void DrawNode::clear()
@@ -350,13 +383,16 @@ void DrawNode::clear()
 	_posColors.clear();
 	_vertices.clear();
 	_indices.clear();
+	markBoundsDirty();
 }
 
 /* DrawRenderer */
 
 DrawRenderer::DrawRenderer():
 _defaultEffect(Effect::create("builtin::vs_draw"_slice, "builtin::fs_draw"_slice)),
-_lastState(BGFX_STATE_NONE)
+_lastState(BGFX_STATE_NONE),
+_compactVertex(false),
+_compactable(true)
 { }
 
 Effect* DrawRenderer::getDefaultEffect() const
@@ -364,6 +400,17 @@ Effect* DrawRenderer::getDefaultEffect() const
 	return _defaultEffect;
 }
 
+void DrawRenderer::setCompactVertex(bool var)
+{
+	render();
+	_compactVertex = var;
+}
+
+bool DrawRenderer::isCompactVertex() const
+{
+	return _compactVertex;
+}
+
 void DrawRenderer::push(DrawNode* node)
 {
 	Uint64 state = node->getRenderState();
@@ -375,6 +422,13 @@ void DrawRenderer::push(DrawNode* node)
 
 	Uint16 start = s_cast<Uint16>(_vertices.size());
 	const auto& verts = node->getVertices();
+	if (_compactVertex && _compactable)
+	{
+		_compactable = std::all_of(verts.begin(), verts.end(), [](const DrawVertex& vert)
+		{
+			return vert.z == 0.0f && vert.w == 1.0f;
+		});
+	}
 	_vertices.reserve(_vertices.size() + verts.size());
 	_vertices.insert(_vertices.end(), verts.begin(), verts.end());
 
@@ -394,18 +448,34 @@ void DrawRenderer::render()
 		bgfx::TransientIndexBuffer indexBuffer;
 		Uint32 vertexCount = s_cast<Uint32>(_vertices.size());
 		Uint32 indexCount = s_cast<Uint32>(_indices.size());
+		bool compact = _compactVertex && _compactable &&
+			(bgfx::getCaps()->supported & BGFX_CAPS_VERTEX_ATTRIB_HALF);
 		if (bgfx::allocTransientBuffers(
-			&vertexBuffer, DrawVertex::ms_decl, vertexCount,
+			&vertexBuffer, compact ? DrawVertex2D::ms_decl : DrawVertex::ms_decl, vertexCount,
 			&indexBuffer, indexCount))
 		{
 			Renderer::render();
-			std::memcpy(vertexBuffer.data, _vertices.data(), _vertices.size() * sizeof(_vertices[0]));
+			if (compact)
+			{
+				DrawVertex2D* verts = r_cast<DrawVertex2D*>(vertexBuffer.data);
+				for (Uint32 i = 0; i < vertexCount; i++)
+				{
+					const DrawVertex& vert = _vertices[i];
+					verts[i] = {vert.x, vert.y, vert.abgr, bx::halfFromFloat(vert.u), bx::halfFromFloat(vert.v)};
+				}
+			}
+			else
+			{
+				std::memcpy(vertexBuffer.data, _vertices.data(), _vertices.size() * sizeof(_vertices[0]));
+			}
 			std::memcpy(indexBuffer.data, _indices.data(), _indices.size() * sizeof(_indices[0]));
 			bgfx::setVertexBuffer(0, &vertexBuffer);
 			bgfx::setIndexBuffer(&indexBuffer);
 			bgfx::setState(_lastState);
+			bgfx::setTransform(SharedDirector.getViewProjection());
 			bgfx::ViewId viewId = SharedView.getId();
-			bgfx::submit(viewId, _defaultEffect->apply());
+			_defaultEffect->apply();
+			bgfx::submit(viewId, _defaultEffect->getWorldProgram());
 		}
 		else
 		{
@@ -414,6 +484,7 @@ void DrawRenderer::render()
 		_vertices.clear();
 		_indices.clear();
 		_lastState = BGFX_STATE_NONE;
+		_compactable = true;
 	}
 }
 
@@ -440,6 +511,7 @@ Line()
 	}
 	_flags.setOn(Line::VertexColorDirty);
 	_flags.setOn(Line::VertexPosDirty);
+	markBoundsDirty();
 }
 
 Line::Line(const Vec2* verts, Uint32 size, Color color):
@@ -456,6 +528,7 @@ Line()
 	}
 	_flags.setOn(Line::VertexColorDirty);
 	_flags.setOn(Line::VertexPosDirty);
+	markBoundsDirty();
 }
 
 void Line::setBlendFunc(BlendFunc var)
@@ -506,6 +579,7 @@ void Line::add(const vector<Vec2>& verts, Color color)
 	}
 	_flags.setOn(Line::VertexColorDirty);
 	_flags.setOn(Line::VertexPosDirty);
+	markBoundsDirty();
 }
 
 void Line::add(const Vec2* verts, Uint32 size, Color color)
@@ -527,6 +601,7 @@ void Line::add(const Vec2* verts, Uint32 size, Color color)
 	}
 	_flags.setOn(Line::VertexColorDirty);
 	_flags.setOn(Line::VertexPosDirty);
+	markBoundsDirty();
 }
 
 void Line::set(const vector<Vec2>& verts, Color color)
@@ -546,6 +621,7 @@ void Line::clear()
 	_posColors.clear();
 	_flags.setOn(Line::VertexColorDirty);
 	_flags.setOn(Line::VertexPosDirty);
+	markBoundsDirty();
 }
 
 void Line::updateRealColor3()
@@ -560,13 +636,25 @@ void Line::updateRealOpacity()
 	_flags.setOn(Line::VertexColorDirty);
 }
 
-const Matrix& Line::getWorld()
+void Line::onWorldChanged()
 {
-	if (_flags.isOn(Node::WorldDirty))
-	{
-		_flags.setOn(Line::VertexPosDirty);
-	}
-	return Node::getWorld();
+	_flags.setOn(Line::VertexPosDirty);
+}
+
+Node* Line::cloneSelf()
+{
+	Line* line = Line::create();
+	line->_renderState = _renderState;
+	line->_blendFunc = _blendFunc;
+	line->_posColors = _posColors;
+	line->_vertices = _vertices;
+	return line;
+}
+
+bool Line::getContentBounds(Rect& bounds)
+{
+	bounds = getPosColorBounds(_posColors);
+	return true;
 }
 
 void Line::render()
@@ -598,8 +686,7 @@ void Line::render()
 	if (_flags.isOn(Line::VertexPosDirty))
 	{
 		_flags.setOff(Line::VertexPosDirty);
-		Matrix transform;
-		bx::mtxMul(transform, _world, SharedDirector.getViewProjection());
+		const Matrix& transform = getWorld();
 		for (size_t i = 0; i < _vertices.size(); i++)
 		{
 			bx::vec4MulMtx(&_vertices[i].x, &_posColors[i].pos.x, transform);
@@ -659,7 +746,15 @@ void LineRenderer::render()
 		{
 			bgfx::allocTransientVertexBuffer(&vertexBuffer, vertexCount, PosColorVertex::ms_decl);
 			Renderer::render();
-			std::memcpy(vertexBuffer.data, _vertices.data(), _vertices.size() * sizeof(_vertices[0]));
+			/* vs_poscolor has no world space variant sharing its vertex
+			 layout, so the view projection is applied here on flush */
+			const Matrix& viewProj = SharedDirector.getViewProjection();
+			PosColorVertex* verts = r_cast<PosColorVertex*>(vertexBuffer.data);
+			for (size_t i = 0; i < _vertices.size(); i++)
+			{
+				verts[i].abgr = _vertices[i].abgr;
+				bx::vec4MulMtx(&verts[i].x, &_vertices[i].x, viewProj);
+			}
 			bgfx::setVertexBuffer(0, &vertexBuffer);
 			bgfx::setState(_lastState);
 			bgfx::ViewId viewId = SharedView.getId();
@@ -38,6 +38,31 @@ struct DrawVertex
 	static Init init;
 };
 
+/** @brief Compact layout for flat draw batches, 16 bytes against 28.
+ The shaders read a_position as (x, y, 0, 1) and the half float texture
+ coordinates as floats, so the builtin programs are shared. */
+struct DrawVertex2D
+{
+	float x;
+	float y;
+	uint32_t abgr;
+	uint16_t u;
+	uint16_t v;
+	struct Init
+	{
+		Init()
+		{
+			ms_decl.begin()
+				.add(bgfx::Attrib::Position, 2, bgfx::AttribType::Float)
+				.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
+				.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Half)
+			.end();
+		}
+	};
+	static bgfx::VertexDecl ms_decl;
+	static Init init;
+};
+
 class Effect;
 
 struct VertexColor
@@ -58,7 +83,6 @@ public:
 	PROPERTY_READONLY_REF(vector<DrawVertex>, Vertices);
 	PROPERTY_READONLY_REF(vector<Uint16>, Indices);
 	virtual void render() override;
-	virtual const Matrix& getWorld() override;
 	void drawDot(const Vec2& pos, float radius, Color color);
 	void drawSegment(const Vec2& from, const Vec2& to, float radius, Color color);
 	void drawPolygon(const vector<Vec2>& verts, Color fillColor, float borderWidth, Color borderColor);
@@ -68,6 +92,9 @@ public:
 	CREATE_FUNC(DrawNode);
 protected:
 	DrawNode();
+	virtual void onWorldChanged() override;
+	virtual bool getContentBounds(Rect& bounds) override;
+	virtual Node* cloneSelf() override;
 	virtual void updateRealColor3() override;
 	virtual void updateRealOpacity() override;
 	void pushVertex(const Vec2& pos, const Vec4& color, const Vec2& coord);
@@ -95,6 +122,9 @@ class DrawRenderer : public Renderer
 {
 public:
 	PROPERTY_READONLY(Effect*, DefaultEffect);
+	/** @brief upload batches of flat vertices as DrawVertex2D
+	 when half float vertex attributes are supported. */
+	PROPERTY_BOOL(CompactVertex);
 	virtual ~DrawRenderer() { }
 	virtual void render() override;
 	void push(DrawNode* node);
@@ -103,6 +133,8 @@ protected:
 private:
 	Ref<Effect> _defaultEffect;
 	Uint64 _lastState;
+	bool _compactVertex;
+	bool _compactable;
 	vector<DrawVertex> _vertices;
 	vector<Uint16> _indices;
 	SINGLETON_REF(DrawRenderer, RendererManager);
@@ -140,7 +172,6 @@ public:
 	PROPERTY_READONLY(Uint64, RenderState);
 	PROPERTY_READONLY_REF(vector<PosColorVertex>, Vertices);
 	virtual void render() override;
-	virtual const Matrix& getWorld() override;
 	void add(const vector<Vec2>& verts, Color color);
 	void add(const Vec2* verts, Uint32 size, Color color);
 	void set(const vector<Vec2>& verts, Color color);
@@ -151,6 +182,9 @@ protected:
 	Line();
 	Line(const vector<Vec2>& verts, Color color);
 	Line(const Vec2* verts, Uint32 size, Color color);
+	virtual void onWorldChanged() override;
+	virtual bool getContentBounds(Rect& bounds) override;
+	virtual Node* cloneSelf() override;
 	virtual void updateRealColor3() override;
 	virtual void updateRealOpacity() override;
 private:
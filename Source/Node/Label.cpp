@@ -275,15 +275,19 @@ const bgfx::GlyphInfo* FontCache::updateCharacter(Sprite* sp, Font* font, bgfx::
 const float Label::AutomaticWidth = -1.0f;
 
 Label::Label(String fontName, Uint32 fontSize):
+Label(SharedFontCache.load(fontName, fontSize))
+{ }
+
+Label::Label(Font* font):
 _alphaRef(0),
 _textWidth(Label::AutomaticWidth),
-_alignment(TextAlign::Center),
-_font(SharedFontCache.load(fontName, fontSize)),
+_font(font),
+_effect(SharedFontCache.getDefaultEffect()),
 _blendFunc(BlendFunc::Default),
-_effect(SharedFontCache.getDefaultEffect())
+_alignment(TextAlign::Center)
 {
 	_lineGap = _font->getInfo().lineGap;
-	_flags.setOff(Node::TraverseEnabled);
+	setTraverseEnabled(false);
 	_flags.setOn(Label::TextBatched);
 }
 
@@ -431,6 +435,7 @@ void Label::setBatched(bool var)
 			}
 		}
 		_flags.setOn(Label::QuadDirty);
+		markBoundsDirty();
 	}
 	else
 	{
@@ -617,6 +622,7 @@ void Label::updateLabel()
 {
 	_text = utf8_get_characters(_textUTF8.c_str());
 	_text.push_back('\0');
+	markBoundsDirty();
 
 	if (_flags.isOn(Label::TextBatched))
 	{
@@ -888,12 +894,6 @@ void Label::updateLabel()
 	}
 }
 
-void Label::cleanup()
-{
-	_font = nullptr;
-	Node::cleanup();
-}
-
 void Label::updateVertTexCoord()
 {
 	_quads.clear();
@@ -981,13 +981,57 @@ void Label::updateRealOpacity()
 	_flags.setOn(Label::VertexColorDirty);
 }
 
-const Matrix& Label::getWorld()
+void Label::onWorldChanged()
 {
-	if (_flags.isOn(Node::WorldDirty))
+	_flags.setOn(Label::VertexPosDirty);
+}
+
+Node* Label::cloneSelf()
+{
+	/* unbatched characters are child sprites owned by the label */
+	if (_flags.isOff(Label::TextBatched)) return nullptr;
+	Label* label = Label::create(_font.get());
+	label->_alphaRef = _alphaRef;
+	label->_textWidth = _textWidth;
+	label->_lineGap = _lineGap;
+	label->_effect = _effect;
+	label->_blendFunc = _blendFunc;
+	label->_alignment = _alignment;
+	label->_textUTF8 = _textUTF8;
+	label->_text = _text;
+	label->_characters.reserve(_characters.size());
+	for (const auto& item : _characters)
 	{
-		_flags.setOn(Label::VertexPosDirty);
+		label->_characters.push_back(item ? New<CharItem>(*item) : Own<CharItem>());
+	}
+	label->_quadPos = _quadPos;
+	label->_quads = _quads;
+	return label;
+}
+
+bool Label::getContentBounds(Rect& bounds)
+{
+	bounds = Rect::zero;
+	/* unbatched characters are child sprites with their own bounds */
+	if (_flags.isOff(Label::TextBatched)) return true;
+	Vec2 lower{FLT_MAX, FLT_MAX};
+	Vec2 upper{-FLT_MAX, -FLT_MAX};
+	for (size_t i = 0; i < _text.size(); i++)
+	{
+		CharItem* item = _characters[i];
+		if (item && item->code != '\n')
+		{
+			float halfW = item->rect.getWidth() * 0.5f;
+			float halfH = item->rect.getHeight() * 0.5f;
+			lower = {std::min(lower.x, item->pos.x - halfW), std::min(lower.y, item->pos.y - halfH)};
+			upper = {std::max(upper.x, item->pos.x + halfW), std::max(upper.y, item->pos.y + halfH)};
+		}
 	}
-	return Node::getWorld();
+	if (lower.x <= upper.x)
+	{
+		bounds = Rect(lower, Size{upper.x - lower.x, upper.y - lower.y});
+	}
+	return true;
 }
 
 void Label::render()
@@ -1012,8 +1056,7 @@ void Label::render()
 	if (_flags.isOn(Label::VertexPosDirty))
 	{
 		_flags.setOff(Label::VertexPosDirty);
-		Matrix transform;
-		bx::mtxMul(transform, _world, SharedDirector.getViewProjection());
+		const Matrix& transform = getWorld();
 		for (size_t i = 0; i < _quadPos.size(); i++)
 		{
 			SpriteQuad& quad = _quads[i];
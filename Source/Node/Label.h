@@ -103,13 +103,15 @@ public:
 	virtual void setRenderOrder(int var) override;
 	Sprite* getCharacter(int index) const;
 	int getCharacterCount() const;
-	virtual void cleanup() override;
 	virtual void render() override;
-	virtual const Matrix& getWorld() override;
 	static const float AutomaticWidth;
 	CREATE_FUNC(Label);
 protected:
 	Label(String fontName, Uint32 fontSize);
+	Label(Font* font);
+	virtual void onWorldChanged() override;
+	virtual bool getContentBounds(Rect& bounds) override;
+	virtual Node* cloneSelf() override;
 	void updateCharacters(const vector<Uint32>& chars);
 	void updateLabel();
 	struct CharItem
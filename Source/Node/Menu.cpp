@@ -17,7 +17,7 @@ _enabled(true),
 _selectedItem(nullptr)
 {
 	setTouchEnabled(true);
-	_flags.setOff(Node::TraverseEnabled);
+	setTraverseEnabled(false);
 }
 
 Menu::Menu(float width, float height):Menu()
@@ -100,12 +100,12 @@ bool Menu::init()
 
 static Node* getTouchedItem(Node* parentItem, const Vec2& worldLocation)
 {
-	Array* children = parentItem->getChildren();
-	if (children && !children->isEmpty())
+	const auto& children = parentItem->getChildList().data();
+	if (!children.empty())
 	{
-		for (int i = s_cast<int>(children->getCount()) - 1; i >= 0; i--)
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
 		{
-			Node* childItem = children->get(i).to<Node>();
+			Node* childItem = it->get();
 			if (childItem && childItem->isVisible() && childItem->isTouchEnabled())
 			{
 				Vec2 local = childItem->convertToNodeSpace(worldLocation);
@@ -120,14 +120,23 @@ static Node* getTouchedItem(Node* parentItem, const Vec2& worldLocation)
 	return parentItem;
 }
 
+bool Menu::getContentBounds(Rect& bounds)
+{
+	/* menu items are children with their own bounds */
+	bounds = Rect::zero;
+	return true;
+}
+
 Node* Menu::itemForTouch(Touch* touch)
 {
 	Vec2 worldLocation = touch->getWorldLocation();
-	if (_children && !_children->isEmpty())
+	sortAllChildren();
+	const auto& children = _children.data();
+	if (!children.empty())
 	{
-		for (int i = s_cast<int>(_children->getCount()) - 1; i >= 0; i--)
+		for (auto it = children.rbegin(); it != children.rend(); ++it)
 		{
-			Node* childItem = _children->get(i).to<Node>();
+			Node* childItem = it->get();
 			if (childItem && childItem->isVisible() && childItem->isTouchEnabled())
 			{
 				Vec2 local = childItem->convertToNodeSpace(worldLocation);
@@ -23,6 +23,7 @@ public:
 protected:
 	Menu();
 	Menu(float width, float height);
+	virtual bool getContentBounds(Rect& bounds) override;
 private:
 	Node* itemForTouch(Touch* touch);
 	bool _enabled;
@@ -51,7 +51,7 @@ _speed(1.0f),
 _recoveryTime(0.0f),
 _currentLookName(Slice::Empty)
 {
-	_flags.setOff(Node::TraverseEnabled);
+	setTraverseEnabled(false);
 }
 
 Model::Model(String filename):
@@ -443,6 +443,13 @@ Rect Model::getBoundingBox()
 	return AffineTransform::applyRect(getLocalTransform(), rect);
 }
 
+bool Model::getContentBounds(Rect& bounds)
+{
+	/* model parts are drawn by the child sprites */
+	bounds = Rect::zero;
+	return true;
+}
+
 Model* Model::none()
 {
 	return Model::create(ModelDef::create());
@@ -140,6 +140,7 @@ public:
 protected:
 	Model(ModelDef* def);
 	Model(String filename);
+	virtual bool getContentBounds(Rect& bounds) override;
 private:
 	typedef unordered_map<string,Node*> NodeMap;
 	void visit(SpriteDef* parentDef, Node* parentNode, ClipDef* clipDef);
@@ -8,24 +8,110 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 
 #include "Const/Header.h"
 #include "Node/Node.h"
+#include "Node/NodePool.h"
+#include "Node/Sprite.h"
 #include "Basic/Director.h"
 #include "Basic/Scheduler.h"
 #include "Input/TouchDispather.h"
 #include "Event/Listener.h"
 #include "Animation/Action.h"
+#include "Animation/Tween.h"
 #include "Basic/Renderer.h"
 #include "Input/Keyboard.h"
 #include "Basic/View.h"
 #include "Basic/Application.h"
+#include "Common/Async.h"
+#include "Common/FrameArena.h"
+#include "bx/float4x4_t.h"
+#include <thread>
 
 NS_DOROTHY_BEGIN
 
+/* NodeList */
+
+NodeList::NodeList():
+_count(0),
+_holes(0),
+_version(0),
+_unsorted(false)
+{ }
+
+void NodeList::insert(Node* node)
+{
+	compact();
+	auto it = std::upper_bound(_nodes.begin(), _nodes.end(), node->_order, [](int order, const Ref<Node>& item)
+	{
+		return order < item->_order;
+	});
+	size_t index = it - _nodes.begin();
+	_nodes.insert(it, MakeRef(node));
+	for (size_t i = index; i < _nodes.size(); i++)
+	{
+		_nodes[i]->_childIndex = s_cast<Uint32>(i);
+	}
+	_count++;
+	_version++;
+}
+
+void NodeList::remove(Node* node)
+{
+	Uint32 index = node->_childIndex;
+	AssertUnless(index < _nodes.size() && _nodes[index].get() == node, "node is not in the children list.");
+	_nodes[index] = nullptr;
+	_count--;
+	_holes++;
+	_version++;
+}
+
+void NodeList::reorder(Node* node)
+{
+	AssertUnless(node->_childIndex < _nodes.size() && _nodes[node->_childIndex].get() == node, "node is not in the children list.");
+	_unsorted = true;
+	_version++;
+}
+
+void NodeList::compact()
+{
+	if (_holes == 0 && !_unsorted) return;
+	if (_holes > 0)
+	{
+		_nodes.erase(std::remove_if(_nodes.begin(), _nodes.end(), [](const Ref<Node>& item)
+		{
+			return !item;
+		}), _nodes.end());
+		_holes = 0;
+	}
+	if (_unsorted)
+	{
+		std::stable_sort(_nodes.begin(), _nodes.end(), [](const Ref<Node>& a, const Ref<Node>& b)
+		{
+			return a->_order < b->_order;
+		});
+		_unsorted = false;
+	}
+	for (size_t i = 0; i < _nodes.size(); i++)
+	{
+		_nodes[i]->_childIndex = s_cast<Uint32>(i);
+	}
+}
+
+void NodeList::clear()
+{
+	_nodes.clear();
+	_count = 0;
+	_holes = 0;
+	_unsorted = false;
+	_version++;
+}
+
+/* Node */
+
 Node::Node():
 _flags(
 	Node::Visible|
 	Node::SelfVisible|Node::ChildrenVisible|
 	Node::PassOpacity|Node::PassColor3|
-	Node::TraverseEnabled),
+	Node::TraverseEnabled|Node::BoundsDirty),
 _order(0),
 _renderOrder(0),
 _color(),
@@ -41,9 +127,14 @@ _position{},
 _anchor{0.5f, 0.5f},
 _anchorPoint{},
 _size{},
+_worldTransform(AffineTransform::Indentity),
 _transform(AffineTransform::Indentity),
 _scheduler(SharedDirector.getScheduler()),
 _parent(nullptr),
+_childIndex(0),
+_tweenCount(0),
+_descendantDirty(false),
+_childArrayVersion(0),
 _touchHandler(nullptr)
 {
 	bx::mtxIdentity(_world);
@@ -57,7 +148,15 @@ void Node::setOrder(int var)
 	if (_order != var)
 	{
 		_order = var;
-		markParentReorder();
+		markBakeDirty();
+		if (_parent)
+		{
+			_parent->_children.reorder(this);
+			if (_flags.isOn(Node::Running))
+			{
+				SharedTouchDispatcher.markTouchNodesDirty();
+			}
+		}
 	}
 }
 
@@ -189,7 +288,15 @@ float Node::getSkewY() const
 
 void Node::setVisible(bool var)
 {
-	_flags.set(Node::Visible, var);
+	if (_flags.isOn(Node::Visible) != var)
+	{
+		_flags.set(Node::Visible, var);
+		markBoundsDirty();
+		if (_flags.isOn(Node::Running))
+		{
+			SharedTouchDispatcher.markTouchNodesDirty();
+		}
+	}
 }
 
 bool Node::isVisible() const
@@ -200,6 +307,7 @@ bool Node::isVisible() const
 void Node::setSelfVisible(bool var)
 {
 	_flags.set(Node::SelfVisible, var);
+	markBoundsDirty();
 }
 
 bool Node::isSelfVisible() const
@@ -210,6 +318,7 @@ bool Node::isSelfVisible() const
 void Node::setChildrenVisible(bool var)
 {
 	_flags.set(Node::ChildrenVisible, var);
+	markBoundsDirty();
 }
 
 bool Node::isChildrenVisible() const
@@ -349,7 +458,8 @@ bool Node::isPassColor3() const
 void Node::setTransformTarget(Node* var)
 {
 	_transformTarget = var;
-	_flags.setOn(Node::WorldDirty);
+	markWorldDirty();
+	markBoundsDirty();
 }
 
 Node* Node::getTransformTarget() const
@@ -359,6 +469,15 @@ Node* Node::getTransformTarget() const
 
 void Node::setScheduler(Scheduler* var)
 {
+	if (_tweenCount > 0)
+	{
+		/* running actions stay with the old scheduler and step their own properties */
+		for (Action* action = _action; action; action = action->_next)
+		{
+			action->untween();
+		}
+		_scheduler->getTweens()->transfer(this, var->getTweens());
+	}
 	if (isUpdating())
 	{
 		_scheduler->unschedule(this);
@@ -422,25 +541,73 @@ bool Node::isRenderGroup() const
 	return _flags.isOn(Node::RenderGrouped);
 }
 
+void Node::setBaked(bool var)
+{
+	if (var == _flags.isOn(Node::Baked)) return;
+	_flags.set(Node::Baked, var);
+	_flags.set(Node::BakeDirty, var);
+	if (!var)
+	{
+		_bakedSprites = nullptr;
+		if (_flags.isOff(Node::InBake))
+		{
+			for (Node* child : _children)
+			{
+				child->traverseAll([](Node* node)
+				{
+					node->_flags.setOff(Node::InBake);
+					return false;
+				});
+			}
+		}
+	}
+}
+
+bool Node::isBaked() const
+{
+	return _flags.isOn(Node::Baked);
+}
+
 Uint32 Node::getNodeCount() const
 {
 	Uint32 count = 1;
-	ARRAY_START(Node, child, _children)
+	for (Node* child : _children)
 	{
 		count += child->getNodeCount();
 	}
-	ARRAY_END
 	return count;
 }
 
+void Node::setPauseWhenCulled(bool var)
+{
+	_flags.set(Node::PauseWhenCulled, var);
+}
+
+bool Node::isPauseWhenCulled() const
+{
+	return _flags.isOn(Node::PauseWhenCulled);
+}
+
+bool Node::isCulled() const
+{
+	for (const Node* node = this; node; node = node->_parent)
+	{
+		if (node->_flags.isOn(Node::Culled)) return true;
+	}
+	return false;
+}
+
 void Node::onEnter()
 {
-	ARRAY_START(Node, child, _children)
+	for (Node* child : _children)
 	{
 		child->onEnter();
 	}
-	ARRAY_END
 	_flags.setOn(Node::Running);
+	if (_flags.isOn(Node::TouchEnabled))
+	{
+		SharedTouchDispatcher.addTouchNode(this);
+	}
 	if (isUpdating() || isScheduled())
 	{
 		_scheduler->schedule(this);
@@ -452,12 +619,15 @@ void Node::onEnter()
 
 void Node::onExit()
 {
-	ARRAY_START(Node, child, _children)
+	for (Node* child : _children)
 	{
 		child->onExit();
 	}
-	ARRAY_END
 	_flags.setOff(Node::Running);
+	if (_flags.isOn(Node::TouchEnabled) && !Singleton<TouchDispatcher>::isDisposed())
+	{
+		SharedTouchDispatcher.removeTouchNode(this);
+	}
 	if (isUpdating() || isScheduled())
 	{
 		_scheduler->unschedule(this);
@@ -467,13 +637,44 @@ void Node::onExit()
 }
 
 Array* Node::getChildren() const
+{
+	if (_children.getVersion() == 0)
+	{
+		return nullptr;
+	}
+	if (!_childArray || _childArrayVersion != _children.getVersion())
+	{
+		/* the list may still hold holes or be unsorted, compacting it here
+		 could shift the slots under an ongoing iteration, so the snapshot
+		 gets the order the next compact() would give instead */
+		vector<Node*> nodes;
+		nodes.reserve(_children.size());
+		for (Node* child : _children)
+		{
+			nodes.push_back(child);
+		}
+		std::stable_sort(nodes.begin(), nodes.end(), [](Node* a, Node* b)
+		{
+			return a->_order < b->_order;
+		});
+		_childArray = Array::create(_children.size());
+		for (Node* child : nodes)
+		{
+			_childArray->add(child);
+		}
+		_childArrayVersion = _children.getVersion();
+	}
+	return _childArray;
+}
+
+const NodeList& Node::getChildList() const
 {
 	return _children;
 }
 
 bool Node::hasChildren() const
 {
-	return _children && !_children->isEmpty();
+	return !_children.empty();
 }
 
 bool Node::isRunning() const
@@ -487,21 +688,14 @@ void Node::addChild(Node* child, int order, String tag)
 	AssertIf(child->_parent, "child already added. It can't be added again.");
 	child->setTag(tag);
 	child->setOrder(order);
-	if (!_children)
-	{
-		_children = Array::create();
-	}
-	Node* last = nullptr;
-	if (!_children->isEmpty())
-	{
-		last = _children->getLast().to<Node>();
-	}
-	_children->add(child);
-	if (last && last->getOrder() > child->getOrder())
+	_children.insert(child);
+	child->_parent = this;
+	if (_flags.isOn(Node::Baked) || _flags.isOn(Node::InBake))
 	{
-		_flags.setOn(Node::Reorder);
+		child->_flags.setOn(Node::InBake);
+		child->markBakeDirty();
 	}
-	child->_parent = this;
+	child->markBoundsDirty();
 	child->updateRealColor3();
 	child->updateRealOpacity();
 	if (_flags.isOn(Node::Running))
@@ -543,23 +737,102 @@ void Node::removeChild(Node* child, bool cleanup)
 {
 	AssertIf(child == nullptr, "remove invalid child (nullptr) from node.");
 	AssertIf(child->_parent != this, "can`t remove child node from different parent.");
-	if (!_children)
-	{
-		return;
-	}
 	Ref<> childRef(child);
-	if (_children->remove(child))
+	_children.remove(child);
+	child->markBoundsDirty();
+	if (child->_flags.isOn(Node::InBake))
 	{
-		if (_flags.isOn(Node::Running))
-		{
-			child->onExit();
-		}
-		if (cleanup)
+		child->traverseAll([](Node* node)
 		{
-			child->cleanup();
-		}
-		child->_parent = nullptr;
+			node->_flags.setOff(Node::InBake);
+			return false;
+		});
 	}
+	if (_flags.isOn(Node::Running))
+	{
+		child->onExit();
+	}
+	if (cleanup)
+	{
+		child->cleanup();
+	}
+	child->_parent = nullptr;
+	if (cleanup && child->_pool)
+	{
+		child->_pool->recycle(child);
+	}
+}
+
+Node* Node::cloneSelf()
+{
+	return getDoraType() == DoraType<Node>() ? Node::create() : nullptr;
+}
+
+Node* Node::clone()
+{
+	Node* node = cloneSelf();
+	if (!node) return nullptr;
+	node->_flags = _flags;
+	node->_flags.setOff(
+		Node::Running|Node::Updating|Node::Scheduling|Node::Cleanup|
+		Node::TouchEnabled|Node::KeyboardEnabled|Node::Culled|
+		Node::BakeDirty|Node::InBake);
+	if (_flags.isOn(Node::Baked))
+	{
+		node->_flags.setOn(Node::BakeDirty);
+	}
+	node->_flags.setOn(
+		Node::TransformDirty|Node::WorldDirty|Node::WorldMatrixDirty|
+		Node::BoundsDirty|Node::ChildBoundsDirty);
+	node->_order = _order;
+	node->_renderOrder = _renderOrder;
+	node->_color = _color;
+	node->_realColor = _realColor;
+	node->_angle = _angle;
+	node->_angleX = _angleX;
+	node->_angleY = _angleY;
+	node->_scaleX = _scaleX;
+	node->_scaleY = _scaleY;
+	node->_skewX = _skewX;
+	node->_skewY = _skewY;
+	node->_positionZ = _positionZ;
+	node->_position = _position;
+	node->_anchor = _anchor;
+	node->_anchorPoint = _anchorPoint;
+	node->_size = _size;
+	node->_tag = _tag;
+	node->_scheduler = _scheduler;
+	if (_flags.isOn(Node::TouchEnabled))
+	{
+		node->setTouchEnabled(true);
+	}
+	if (_flags.isOn(Node::KeyboardEnabled))
+	{
+		node->setKeyboardEnabled(true);
+	}
+	for (Node* child : _children)
+	{
+		Node* childClone = child->clone();
+		if (!childClone) return nullptr;
+		node->addChild(childClone, child->_order, child->_tag);
+	}
+	/* runAction() pushes to the list front, so copy from the back to keep the order */
+	vector<Action*> actions;
+	for (Action* action = _action; action; action = action->_next)
+	{
+		actions.push_back(action);
+	}
+	for (auto it = actions.rbegin(); it != actions.rend(); ++it)
+	{
+		Action* action = *it;
+		Action* actionClone = Action::create(action->_action->clone());
+		actionClone->_reversed = action->_reversed;
+		actionClone->_speed = action->_speed;
+		node->runAction(actionClone);
+		actionClone->_eclapsed = action->_eclapsed;
+		if (action->_paused) actionClone->pause();
+	}
+	return node;
 }
 
 void Node::removeChildByTag(String tag, bool cleanup)
@@ -569,8 +842,18 @@ void Node::removeChildByTag(String tag, bool cleanup)
 
 void Node::removeAllChildren(bool cleanup)
 {
-	ARRAY_START(Node, child, _children)
+	if (_flags.isOn(Node::Baked))
+	{
+		_flags.setOn(Node::BakeDirty);
+	}
+	markBakeDirty();
+	for (Node* child : _children)
 	{
+		child->traverseAll([](Node* node)
+		{
+			node->_flags.setOff(Node::InBake);
+			return false;
+		});
 		if (_flags.isOn(Node::Running))
 		{
 			child->onExit();
@@ -580,12 +863,12 @@ void Node::removeAllChildren(bool cleanup)
 			child->cleanup();
 		}
 		child->_parent = nullptr;
+		if (cleanup && child->_pool)
+		{
+			child->_pool->recycle(child);
+		}
 	}
-	ARRAY_END
-	if (_children)
-	{
-		_children->clear();
-	}
+	_children.clear();
 }
 
 void Node::removeFromParent(bool cleanup)
@@ -599,14 +882,15 @@ void Node::cleanup()
 	{
 		_flags.setOn(Node::Cleanup);
 		emit("Cleanup"_slice);
-		ARRAY_START(Node, child, _children)
+		for (Node* child : _children)
 		{
 			child->cleanup();
 		}
-		ARRAY_END
 		unschedule();
 		unscheduleUpdate();
 		stopActionInList(_action);
+		stopAllTweens();
+		_bakedSprites = nullptr;
 		_userData = nullptr;
 		_signal = nullptr;
 		if (_flags.isOn(Node::KeyboardEnabled))
@@ -673,6 +957,22 @@ void Node::setTouchEnabled(bool var)
 		_touchHandler->setSwallowTouches(_flags.isOn(Node::SwallowTouches));
 	}
 	_flags.set(Node::TouchEnabled, var);
+	if (_flags.isOn(Node::Running))
+	{
+		if (var) SharedTouchDispatcher.addTouchNode(this);
+		else SharedTouchDispatcher.removeTouchNode(this);
+	}
+}
+
+void Node::setTraverseEnabled(bool var)
+{
+	if (_flags.isOn(Node::TraverseEnabled) == var) return;
+	_flags.set(Node::TraverseEnabled, var);
+	/* touch nodes under this node are registered by traversable paths */
+	if (_flags.isOn(Node::Running))
+	{
+		SharedTouchDispatcher.markTouchNodesDirty();
+	}
 }
 
 bool Node::isTouchEnabled() const
@@ -779,6 +1079,33 @@ bool Node::update(double deltaTime)
 	return result && !isUpdating();
 }
 
+/* test the world space bounds against the clip volume, empty bounds
+ have nothing to render and bounds crossing the camera plane are kept */
+static bool isBoundsInView(const Rect& bounds, const Matrix& viewProj)
+{
+	if (bounds.size == Size::zero) return false;
+	Vec2 lower = bounds.getLowerBound();
+	Vec2 upper = bounds.getUpperBound();
+	const float corners[4][4] = {
+		{lower.x, lower.y, 0.0f, 1.0f},
+		{upper.x, lower.y, 0.0f, 1.0f},
+		{lower.x, upper.y, 0.0f, 1.0f},
+		{upper.x, upper.y, 0.0f, 1.0f}
+	};
+	int left = 0, right = 0, below = 0, above = 0;
+	for (const auto& corner : corners)
+	{
+		float pos[4];
+		bx::vec4MulMtx(pos, corner, viewProj);
+		if (pos[3] <= FLT_EPSILON) return true;
+		if (pos[0] < -pos[3]) left++;
+		else if (pos[0] > pos[3]) right++;
+		if (pos[1] < -pos[3]) below++;
+		else if (pos[1] > pos[3]) above++;
+	}
+	return left < 4 && right < 4 && below < 4 && above < 4;
+}
+
 void Node::visit()
 {
 	if (_flags.isOff(Node::Visible))
@@ -786,22 +1113,57 @@ void Node::visit()
 		return;
 	}
 
-	/* get world matrix */
-	getWorld();
+	/* get world transform */
+	updateWorld();
+
+	/* skip the whole subtree when its cached bounds are out of view */
+	if (updateBounds() && !isBoundsInView(_bounds, SharedDirector.getViewProjection()))
+	{
+		_flags.setOn(Node::Culled);
+		return;
+	}
+	_flags.setOff(Node::Culled);
 
 	auto& rendererManager = SharedRendererManager;
-	if (_children && !_children->isEmpty() && _flags.isOn(Node::ChildrenVisible))
+	if (_flags.isOn(Node::Baked) && !rendererManager.isGrouping() &&
+		!_children.empty() && _flags.isOn(Node::ChildrenVisible))
+	{
+		if (_flags.isOn(Node::BakeDirty))
+		{
+			_flags.setOff(Node::BakeDirty);
+			if (!_bakedSprites) _bakedSprites = New<BakedSprites>();
+			if (!_bakedSprites->build(this)) _bakedSprites = nullptr;
+		}
+		if (_bakedSprites)
+		{
+			/* draw the baked children behind and in front of self */
+			const Matrix& world = getWorld();
+			Uint32 backCount = _bakedSprites->getBackCount();
+			rendererManager.flush();
+			_bakedSprites->render(world, 0, backCount);
+			if (_flags.isOn(Node::SelfVisible))
+			{
+				render();
+				rendererManager.flush();
+			}
+			_bakedSprites->render(world, backCount, _bakedSprites->getBatchCount());
+			return;
+		}
+	}
+	if (!_children.empty() && _flags.isOn(Node::ChildrenVisible))
 	{
 		sortAllChildren();
 
 		auto visitChildren = [&]()
 		{
-			/* visit and render child whose order is less than 0 */
+			/* visit and render child whose order is less than 0,
+			 slots emptied by removals during visiting are skipped */
 			size_t index = 0;
-			RefVector<Object>& data = _children->data();
+			const vector<Ref<Node>>& data = _children.data();
 			for (index = 0; index < data.size(); index++)
 			{
-				Node* node = data[index].to<Node>();
+				Node* node = data[index].get();
+				if (!node) continue;
 				if (node->getOrder() >= 0) break;
 				node->visit();
 			}
@@ -819,8 +1181,8 @@ void Node::visit()
 			/* visit and render child whose order is greater equal than 0 */
 			for (; index < data.size(); index++)
 			{
-				Node* node = data[index].to<Node>();
-				node->visit();
+				Node* node = data[index].get();
+				if (node) node->visit();
 			}
 		};
 
@@ -847,47 +1209,57 @@ const AffineTransform& Node::getLocalTransform()
 {
 	if (_flags.isOn(Node::TransformDirty))
 	{
-		/* cos(rotateZ), sin(rotateZ) */
-		float c = 1, s = 0;
-		if (_angle)
-		{
-			float radians = -bx::toRad(_angle);
-			c = std::cos(radians);
-			s = std::sin(radians);
-		}
-		if (_skewX || _skewY)
-		{
-			/* translateXY, rotateZ, scaleXY */
-			_transform = {c * _scaleX, s * _scaleX, -s * _scaleY, c * _scaleY, _position.x, _position.y};
+		updateLocalTransform();
+		_flags.setOff(Node::TransformDirty);
+	}
+	return _transform;
+}
 
-			/* skewXY */
-			AffineTransform skewMatrix {
-				1.0f, std::tan(bx::toRad(_skewY)),
-				std::tan(bx::toRad(_skewX)), 1.0f,
-				0.0f, 0.0f};
-			_transform = AffineTransform::concat(skewMatrix, _transform);
+void Node::updateLocalTransform()
+{
+	computeLocalTransform(_position, _angle);
+}
 
-			/* translateAnchorXY */
-			if (_anchorPoint != Vec2::zero)
-			{
-				_transform = AffineTransform::translate(_transform, -_anchorPoint.x, -_anchorPoint.y);
-			}
+void Node::computeLocalTransform(const Vec2& position, float angle)
+{
+	/* cos(rotateZ), sin(rotateZ) */
+	float c = 1, s = 0;
+	if (angle)
+	{
+		float radians = -bx::toRad(angle);
+		c = std::cos(radians);
+		s = std::sin(radians);
+	}
+	if (_skewX || _skewY)
+	{
+		/* translateXY, rotateZ, scaleXY */
+		_transform = {c * _scaleX, s * _scaleX, -s * _scaleY, c * _scaleY, position.x, position.y};
+
+		/* skewXY */
+		AffineTransform skewMatrix {
+			1.0f, std::tan(bx::toRad(_skewY)),
+			std::tan(bx::toRad(_skewX)), 1.0f,
+			0.0f, 0.0f};
+		_transform = AffineTransform::concat(skewMatrix, _transform);
+
+		/* translateAnchorXY */
+		if (_anchorPoint != Vec2::zero)
+		{
+			_transform = AffineTransform::translate(_transform, -_anchorPoint.x, -_anchorPoint.y);
 		}
-		else
+	}
+	else
+	{
+		/* translateXY, scaleXY, rotateZ, translateAnchorXY */
+		float x = position.x;
+		float y = position.y;
+		if (_anchorPoint != Vec2::zero)
 		{
-			/* translateXY, scaleXY, rotateZ, translateAnchorXY */
-			float x = _position.x;
-			float y = _position.y;
-			if (_anchorPoint != Vec2::zero)
-			{
-				x += c * -_anchorPoint.x * _scaleX + -s * -_anchorPoint.y * _scaleY;
-				y += s * -_anchorPoint.x * _scaleX + c * -_anchorPoint.y * _scaleY;
-			}
-			_transform = {c * _scaleX, s * _scaleX, -s * _scaleY, c * _scaleY, x, y};
+			x += c * -_anchorPoint.x * _scaleX + -s * -_anchorPoint.y * _scaleY;
+			y += s * -_anchorPoint.x * _scaleX + c * -_anchorPoint.y * _scaleY;
 		}
-		_flags.setOff(Node::TransformDirty);
+		_transform = {c * _scaleX, s * _scaleX, -s * _scaleY, c * _scaleY, x, y};
 	}
-	return _transform;
 }
 
 void Node::getLocalWorld(Matrix& localWorld)
@@ -943,33 +1315,329 @@ void Node::getLocalWorld(Matrix& localWorld)
 	}
 }
 
-const Matrix& Node::getWorld()
+void Node::onWorldChanged()
+{ }
+
+bool Node::getContentBounds(Rect& bounds)
 {
-	if (_flags.isOn(Node::WorldDirty))
+	/* a plain node draws nothing, subclasses are culled
+	 only when they override this with their content bounds */
+	bounds = Rect::zero;
+	return getDoraType() == DoraType<Node>();
+}
+
+static void mergeBounds(Rect& bounds, const Rect& other)
+{
+	if (other.size == Size::zero) return;
+	if (bounds.size == Size::zero)
+	{
+		bounds = other;
+		return;
+	}
+	Vec2 lower = bounds.getLowerBound();
+	Vec2 upper = bounds.getUpperBound();
+	Vec2 otherLower = other.getLowerBound();
+	Vec2 otherUpper = other.getUpperBound();
+	lower = {std::min(lower.x, otherLower.x), std::min(lower.y, otherLower.y)};
+	upper = {std::max(upper.x, otherUpper.x), std::max(upper.y, otherUpper.y)};
+	bounds = Rect(lower, Size{upper.x - lower.x, upper.y - lower.y});
+}
+
+bool Node::updateBounds()
+{
+	if (_flags.isOff(Node::BoundsDirty) && _flags.isOff(Node::ChildBoundsDirty))
+	{
+		return _flags.isOff(Node::Unbounded);
+	}
+	/* a dirty node moved its whole subtree, a node with only dirty
+	 children reuses the cached bounds of the clean ones */
+	bool subtreeDirty = _flags.isOn(Node::BoundsDirty);
+	_flags.setOff(Node::BoundsDirty);
+	_flags.setOff(Node::ChildBoundsDirty);
+	updateWorld();
+	Rect content;
+	bool bounded = !_transformTarget && _flags.isOff(Node::World3D) && getContentBounds(content);
+	_bounds = Rect::zero;
+	if (bounded && _flags.isOn(Node::SelfVisible) && content.size != Size::zero)
+	{
+		_bounds = AffineTransform::applyRect(_worldTransform, content);
+	}
+	if (!_children.empty())
+	{
+		bool childrenVisible = _flags.isOn(Node::ChildrenVisible);
+		for (Node* child : _children)
+		{
+			if (subtreeDirty)
+			{
+				child->_flags.setOn(Node::BoundsDirty);
+			}
+			if (bounded && childrenVisible && child->_flags.isOn(Node::Visible))
+			{
+				if (child->updateBounds()) mergeBounds(_bounds, child->_bounds);
+				else bounded = false;
+			}
+		}
+	}
+	_flags.set(Node::Unbounded, !bounded);
+	return bounded;
+}
+
+static void mulWorld(Matrix& result, const Matrix& local, const Matrix& parent)
+{
+	bx::float4x4_t a, b, c;
+	std::memcpy(&a, local.m, sizeof(Matrix));
+	std::memcpy(&b, parent.m, sizeof(Matrix));
+	bx::float4x4_mul(&c, &a, &b);
+	std::memcpy(result.m, &c, sizeof(Matrix));
+}
+
+void Node::computeWorld()
+{
+	bool parent3D = _parent && _parent->_flags.isOn(Node::World3D);
+	if (parent3D || _angleX || _angleY || _positionZ)
 	{
-		_flags.setOff(WorldDirty);
 		Matrix localWorld;
 		getLocalWorld(localWorld);
-		const Matrix* parentWorld = &Matrix::Indentity;
+		if (parent3D)
+		{
+			mulWorld(_world, localWorld, _parent->_world);
+		}
+		else if (_parent)
+		{
+			Matrix parentWorld;
+			AffineTransform::toMatrix(_parent->_worldTransform, parentWorld);
+			mulWorld(_world, localWorld, parentWorld);
+		}
+		else _world = localWorld;
+		_flags.setOn(Node::World3D);
+		_flags.setOff(Node::WorldMatrixDirty);
+	}
+	else
+	{
+		/* 2D only nodes keep an affine world and expand it to 4x4 on request */
+		if (_parent)
+		{
+			_worldTransform = AffineTransform::concat(getLocalTransform(), _parent->_worldTransform);
+		}
+		else _worldTransform = getLocalTransform();
+		_flags.setOff(Node::World3D);
+		_flags.setOn(Node::WorldMatrixDirty);
+	}
+}
+
+void Node::updateWorld()
+{
+	if (_flags.isOn(Node::WorldDirty))
+	{
+		onWorldChanged();
+		_flags.setOff(WorldDirty);
 		if (_transformTarget)
 		{
-			parentWorld = &_transformTarget->getWorld();
+			Matrix localWorld;
+			getLocalWorld(localWorld);
+			mulWorld(_world, localWorld, _transformTarget->getWorld());
+			_flags.setOn(Node::World3D);
+			_flags.setOff(Node::WorldMatrixDirty);
 			_flags.setOn(Node::WorldDirty);
 		}
-		else if (_parent)
+		else
 		{
-			parentWorld = &_parent->getWorld();
+			if (_parent) _parent->updateWorld();
+			computeWorld();
 		}
-		bx::mtxMul(_world, localWorld, *parentWorld);
-		ARRAY_START(Node, child, _children)
+		for (Node* child : _children)
 		{
 			child->_flags.setOn(Node::WorldDirty);
 		}
-		ARRAY_END
+		if (!_children.empty()) markDescendantDirty();
+	}
+}
+
+const Matrix& Node::getWorld()
+{
+	updateWorld();
+	if (_flags.isOn(Node::WorldMatrixDirty))
+	{
+		_flags.setOff(Node::WorldMatrixDirty);
+		AffineTransform::toMatrix(_worldTransform, _world);
 	}
 	return _world;
 }
 
+void Node::updateWorlds(Node* root)
+{
+	if (!root || root->_flags.isOff(Node::Visible)) return;
+	if (root->_parent) root->_parent->updateWorld();
+
+	/* flatten the dirty nodes in pre-order so that every parent
+	 is placed before its children */
+	struct Item
+	{
+		Node* node;
+		int parent;
+		int depth;
+	};
+	FrameVector<Item> stack;
+	FrameVector<Item> items;
+	FrameVector<Node*> skipped;
+	int maxDepth = 0;
+	stack.push_back({root, -1, 0});
+	while (!stack.empty())
+	{
+		Item item = stack.back();
+		stack.pop_back();
+		Node* node = item.node;
+		/* nodes following transform targets stay dirty and are updated by visit */
+		if (node->_transformTarget)
+		{
+			if (node->_parent) skipped.push_back(node->_parent);
+			continue;
+		}
+		int slot = -1;
+		if (item.parent >= 0 || node->_flags.isOn(Node::WorldDirty))
+		{
+			node->onWorldChanged();
+			node->_flags.setOff(Node::WorldDirty);
+			slot = s_cast<int>(items.size());
+			items.push_back(item);
+			maxDepth = std::max(maxDepth, item.depth);
+		}
+		/* walk down only the subtrees holding dirty nodes */
+		bool descend = slot >= 0 || node->_descendantDirty;
+		node->_descendantDirty = false;
+		if (descend && !node->_children.empty())
+		{
+			bool childrenVisible = node->_flags.isOn(Node::ChildrenVisible);
+			bool keepDirty = false;
+			const vector<Ref<Node>>& data = node->_children.data();
+			for (auto it = data.rbegin(); it != data.rend(); ++it)
+			{
+				Node* child = it->get();
+				if (!child) continue;
+				bool childDirty = child->_flags.isOn(Node::WorldDirty) || child->_descendantDirty;
+				if (childrenVisible && child->_flags.isOn(Node::Visible))
+				{
+					if (slot >= 0 || childDirty)
+					{
+						stack.push_back({child, slot, item.depth + 1});
+					}
+				}
+				else
+				{
+					if (slot >= 0) child->_flags.setOn(Node::WorldDirty);
+					keepDirty = keepDirty || slot >= 0 || childDirty;
+				}
+			}
+			if (keepDirty) skipped.push_back(node);
+		}
+	}
+	/* keep the marks leading to the hidden dirty nodes for the next update */
+	for (Node* node : skipped)
+	{
+		node->markDescendantDirty();
+	}
+	if (items.empty()) return;
+
+	auto compute = [&](size_t index)
+	{
+		items[index].node->computeWorld();
+	};
+
+	/* split at the shallowest depth with enough subtrees to feed every worker */
+	const size_t ParallelThreshold = 4096;
+	Uint32 workerCount = SharedAsyncThread.getWorkerCount();
+	int splitDepth = -1;
+	if (items.size() >= ParallelThreshold)
+	{
+		FrameVector<size_t> depthCounts(maxDepth + 1, 0);
+		for (const auto& item : items)
+		{
+			depthCounts[item.depth]++;
+		}
+		for (int depth = 1; depth <= maxDepth; depth++)
+		{
+			if (depthCounts[depth] >= workerCount * 4)
+			{
+				splitDepth = depth - 1;
+				break;
+			}
+		}
+	}
+	if (splitDepth < 0)
+	{
+		for (size_t i = 0; i < items.size(); i++)
+		{
+			compute(i);
+		}
+		return;
+	}
+
+	/* update the shallow levels first, then the subtrees below them are independent */
+	FrameVector<std::pair<size_t, size_t>> chunks;
+	size_t chunkSize = std::max(items.size() / (workerCount * 4), s_cast<size_t>(256));
+	size_t chunkStart = items.size();
+	for (size_t i = 0; i < items.size(); i++)
+	{
+		const Item& item = items[i];
+		if (item.depth <= splitDepth)
+		{
+			compute(i);
+			continue;
+		}
+		bool subtreeRoot = item.depth == splitDepth + 1;
+		if (subtreeRoot && chunkStart < i && i - chunkStart >= chunkSize)
+		{
+			chunks.emplace_back(chunkStart, i);
+			chunkStart = i;
+		}
+		else if (chunkStart == items.size())
+		{
+			chunkStart = i;
+		}
+	}
+	if (chunkStart < items.size())
+	{
+		chunks.emplace_back(chunkStart, items.size());
+	}
+
+	struct Batch
+	{
+		std::atomic<size_t> next;
+		std::atomic<size_t> done;
+		size_t count;
+		function<void()> work;
+	};
+	auto batch = std::make_shared<Batch>();
+	batch->next = 0;
+	batch->done = 0;
+	batch->count = chunks.size();
+	Batch* current = batch.get();
+	batch->work = [&, current]()
+	{
+		for (size_t c = current->next++; c < current->count; c = current->next++)
+		{
+			for (size_t i = chunks[c].first; i < chunks[c].second; i++)
+			{
+				if (items[i].depth > splitDepth) compute(i);
+			}
+			current->done++;
+		}
+	};
+	for (Uint32 i = 1; i < workerCount && i < chunks.size(); i++)
+	{
+		/* jobs started after all chunks are taken return without touching the batch data */
+		SharedAsyncThread.run([batch]()
+		{
+			if (batch->next < batch->count) batch->work();
+		}, AsyncPriority::High);
+	}
+	batch->work();
+	while (batch->done < batch->count)
+	{
+		std::this_thread::yield();
+	}
+}
+
 void Node::emit(Event* event)
 {
 	if (_signal)
@@ -978,6 +1646,11 @@ void Node::emit(Event* event)
 	}
 }
 
+bool Node::hasSlot(Uint32 eventId) const
+{
+	return _signal && _signal->hasSlot(eventId);
+}
+
 Slot* Node::slot(String name)
 {
 	if (!_signal)
@@ -996,6 +1669,15 @@ Slot* Node::slot(String name, const EventHandler& handler)
 	return _signal->addSlot(name, handler);
 }
 
+Slot* Node::slot(Uint32 eventId, const EventHandler& handler)
+{
+	if (!_signal)
+	{
+		_signal = New<Signal>();
+	}
+	return _signal->addSlot(eventId, handler);
+}
+
 void Node::slot(String name, std::nullptr_t)
 {
 	if (_signal)
@@ -1041,25 +1723,74 @@ RefVector<Listener> Node::gslot(String name)
 void Node::markDirty()
 {
 	_flags.setOn(Node::TransformDirty);
+	markWorldDirty();
+	markBoundsDirty();
+}
+
+void Node::markWorldDirty()
+{
 	_flags.setOn(Node::WorldDirty);
+	if (_parent) _parent->markDescendantDirty();
 }
 
-void Node::sortAllChildren()
+void Node::markDescendantDirty()
 {
-	if (_flags.isOn(Node::Reorder))
+	for (Node* node = this; node && !node->_descendantDirty; node = node->_parent)
 	{
-		RefVector<Object>& data = _children->data();
-		std::stable_sort(data.begin(), data.end(), [](const Ref<>& a, const Ref<>& b)
+		node->_descendantDirty = true;
+	}
+}
+
+bool Node::reviveSelf()
+{
+	return true;
+}
+
+bool Node::revive()
+{
+	bool revived = true;
+	traverseAll([&](Node* node)
+	{
+		node->_flags.setOff(Node::Cleanup);
+		node->_flags.setOff(Node::Culled);
+		node->resetWeakRef();
+		node->markDirty();
+		if (!node->reviveSelf())
 		{
-			return a.to<Node>()->getOrder() < b.to<Node>()->getOrder();
-		});
-		_flags.setOff(Node::Reorder);
+			revived = false;
+			return true;
+		}
+		return false;
+	});
+	return revived;
+}
+
+void Node::markBakeDirty()
+{
+	if (_flags.isOff(Node::InBake)) return;
+	for (Node* node = _parent; node; node = node->_parent)
+	{
+		if (node->_flags.isOn(Node::Baked))
+		{
+			node->_flags.setOn(Node::BakeDirty);
+		}
+		if (node->_flags.isOff(Node::InBake)) break;
 	}
 }
 
-void Node::markParentReorder()
+void Node::markBoundsDirty()
 {
-	if (_parent) _parent->_flags.setOn(Node::Reorder);
+	markBakeDirty();
+	_flags.setOn(Node::BoundsDirty);
+	for (Node* node = _parent; node && node->_flags.isOff(Node::ChildBoundsDirty); node = node->_parent)
+	{
+		node->_flags.setOn(Node::ChildBoundsDirty);
+	}
+}
+
+void Node::sortAllChildren()
+{
+	_children.compact();
 }
 
 void Node::updateRealColor3()
@@ -1075,13 +1806,13 @@ void Node::updateRealColor3()
 	{
 		_realColor = _color;
 	}
+	markBakeDirty();
 	if (_flags.isOn(Node::PassColor3))
 	{
-		ARRAY_START(Node, child, _children)
+		for (Node* child : _children)
 		{
 			child->updateRealColor3();
 		}
-		ARRAY_END
 	}
 }
 
@@ -1096,13 +1827,13 @@ void Node::updateRealOpacity()
 	{
 		_realColor.setOpacity(_color.getOpacity());
 	}
+	markBakeDirty();
 	if (_flags.isOn(Node::PassOpacity))
 	{
-		ARRAY_START(Node, child, _children)
+		for (Node* child : _children)
 		{
 			child->updateRealOpacity();
 		}
-		ARRAY_END
 	}
 }
 
@@ -1155,6 +1886,24 @@ void Node::perform(Action* action)
 	runAction(action);
 }
 
+void Node::tween(Property::Enum prop, float duration, float start, float stop, Ease::Enum easing)
+{
+	_scheduler->getTweens()->start(this, prop, duration, start, stop, easing);
+}
+
+bool Node::stopTween(Property::Enum prop)
+{
+	return _scheduler->getTweens()->stop(this, prop);
+}
+
+void Node::stopAllTweens()
+{
+	if (_tweenCount > 0)
+	{
+		_scheduler->getTweens()->stop(this);
+	}
+}
+
 bool Node::hasAction(Action* action)
 {
 	bool found = false;
@@ -1242,7 +1991,7 @@ Size Node::alignItemsVertically(const Size& size, float padding)
 {
 	float width = size.width;
 	float y = size.height - padding;
-	ARRAY_START(Node, child, _children)
+	for (Node* child : _children)
 	{
 		float realWidth = child->getWidth() * child->getScaleX();
 		float realHeight = child->getHeight() * child->getScaleY();
@@ -1254,8 +2003,7 @@ Size Node::alignItemsVertically(const Size& size, float padding)
 		y -= child->getAnchor().y * realHeight;
 		y -= padding;
 	}
-	ARRAY_END
-	return _children && !_children->isEmpty() ? Size{size.width, size.height - y} : Size::zero;
+	return !_children.empty() ? Size{size.width, size.height - y} : Size::zero;
 }
 
 Size Node::alignItemsHorizontally(float padding)
@@ -1267,7 +2015,7 @@ Size Node::alignItemsHorizontally(const Size& size, float padding)
 {
 	float height = size.height;
 	float x = padding;
-	ARRAY_START(Node, child, _children)
+	for (Node* child : _children)
 	{
 		float realWidth = child->getWidth() * child->getScaleX();
 		float realHeight = child->getHeight() * child->getScaleY();
@@ -1279,8 +2027,7 @@ Size Node::alignItemsHorizontally(const Size& size, float padding)
 		x += (1.0f - child->getAnchor().x) * realWidth;
 		x += padding;
 	}
-	ARRAY_END
-	return _children && !_children->isEmpty() ? Size{x, size.height} : Size::zero;
+	return !_children.empty() ? Size{x, size.height} : Size::zero;
 }
 
 Size Node::alignItems(float padding)
@@ -1297,7 +2044,7 @@ Size Node::alignItems(const Size& size, float padding)
 	int rows = 0;
 	float curY = y;
 	float maxX = 0;
-	ARRAY_START(Node, child, _children)
+	for (Node* child : _children)
 	{
 		float realWidth = child->getWidth() * child->getScaleX();
 		float realHeight = child->getHeight() * child->getScaleY();
@@ -1328,14 +2075,13 @@ Size Node::alignItems(const Size& size, float padding)
 			curY = y - realHeight;
 		}
 	}
-	ARRAY_END
-	return _children && !_children->isEmpty() ? Size{maxX, height - curY + 10.0f} : Size::zero;
+	return !_children.empty() ? Size{maxX, height - curY + 10.0f} : Size::zero;
 }
 
 void Node::moveAndCullItems(const Vec2& delta)
 {
 	Rect contentRect(Vec2::zero, getSize());
-	ARRAY_START(Node, child, _children)
+	for (Node* child : _children)
 	{
 		child->setPosition(child->getPosition() + delta);
 		const Vec2& pos = child->getPosition();
@@ -1351,7 +2097,6 @@ void Node::moveAndCullItems(const Vec2& delta)
 			child->setVisible(contentRect.intersectsRect(childRect));
 		}
 	}
-	ARRAY_END
 }
 
 void Node::handleKeyboard(Event* event)
@@ -1510,60 +2255,71 @@ void Slot::handle(Event* event)
 
 const size_t Signal::MaxSlotArraySize = 5;
 
-Slot* Signal::addSlot(String name, const EventHandler& handler)
+Slot* Signal::getSlot(Uint32 eventId) const
 {
 	if (_slots)
 	{
-		auto it = _slots->find(name);
+		auto it = _slots->find(eventId);
 		if (it != _slots->end())
 		{
-			it->second->add(handler);
 			return it->second;
 		}
-		else
-		{
-			Slot* slot = Slot::create(handler);
-			(*_slots)[name] = slot;
-			return slot;
-		}
 	}
 	else if (_slotsArray)
 	{
-		for (auto& item : *_slotsArray)
+		for (const auto& item : *_slotsArray)
 		{
-			if (name == item.first)
+			if (eventId == item.first)
 			{
-				item.second->add(handler);
 				return item.second;
 			}
 		}
-		if (_slotsArray->size() < Signal::MaxSlotArraySize)
-		{
-			Slot* slot = Slot::create(handler);
-			_slotsArray->push_back(
-				std::make_pair(name.toString(), MakeRef(slot)));
-			return slot;
-		}
-		else
+	}
+	return nullptr;
+}
+
+bool Signal::hasSlot(Uint32 eventId) const
+{
+	return getSlot(eventId) != nullptr;
+}
+
+Slot* Signal::addSlot(Uint32 eventId, const EventHandler& handler)
+{
+	if (Slot* slot = getSlot(eventId))
+	{
+		slot->add(handler);
+		return slot;
+	}
+	Slot* slot = Slot::create(handler);
+	if (_slots)
+	{
+		(*_slots)[eventId] = slot;
+	}
+	else if (_slotsArray && _slotsArray->size() >= Signal::MaxSlotArraySize)
+	{
+		_slots = New<unordered_map<Uint32, Ref<Slot>>>();
+		for (auto& item : *_slotsArray)
 		{
-			_slots = New<unordered_map<string, Ref<Slot>>>();
-			for (auto& item : *_slotsArray)
-			{
-				(*_slots)[item.first] = item.second;
-			}
-			Slot* slot = Slot::create(handler);
-			(*_slots)[name] = slot;
-			_slotsArray = nullptr;
-			return slot;
+			(*_slots)[item.first] = item.second;
 		}
+		(*_slots)[eventId] = slot;
+		_slotsArray = nullptr;
 	}
 	else
 	{
-		_slotsArray = New<vector<std::pair<string, Ref<Slot>>>>(MaxSlotArraySize);
-		Slot* slot = Slot::create(handler);
-		_slotsArray->push_back(std::make_pair(name.toString(), MakeRef(slot)));
-		return slot;
+		if (!_slotsArray)
+		{
+			_slotsArray = New<vector<std::pair<Uint32, Ref<Slot>>>>();
+			_slotsArray->reserve(MaxSlotArraySize);
+		}
+		_slotsArray->push_back(std::make_pair(eventId, MakeRef(slot)));
 	}
+	return slot;
+}
+
+Slot* Signal::addSlot(String name, const EventHandler& handler)
+{
+	return addSlot(Event::intern(name), handler);
 }
 
 Listener* Signal::addGSlot(String name, const EventHandler& handler)
@@ -1575,25 +2331,9 @@ Listener* Signal::addGSlot(String name, const EventHandler& handler)
 
 void Signal::removeSlot(String name, const EventHandler& handler)
 {
-	if (_slots)
+	if (Slot* slot = getSlot(Event::find(name)))
 	{
-		auto it = _slots->find(name);
-		if (it != _slots->end())
-		{
-			it->second->remove(handler);
-			return;
-		}
-	}
-	else if (_slotsArray)
-	{
-		for (auto& item : *_slotsArray)
-		{
-			if (name == item.first)
-			{
-				item.second->remove(handler);
-				return;
-			}
-		}
+		slot->remove(handler);
 	}
 }
 
@@ -1604,9 +2344,11 @@ void Signal::removeGSlot(Listener* gslot)
 
 void Signal::removeSlots(String name)
 {
+	Uint32 eventId = Event::find(name);
+	if (eventId == Event::InvalidId) return;
 	if (_slots)
 	{
-		auto it = _slots->find(name);
+		auto it = _slots->find(eventId);
 		if (it != _slots->end())
 		{
 			it->second->clear();
@@ -1617,7 +2359,7 @@ void Signal::removeSlots(String name)
 	{
 		for (auto it = _slotsArray->begin(); it != _slotsArray->end(); ++it)
 		{
-			if (name == it->first)
+			if (eventId == it->first)
 			{
 				_slotsArray->erase(it);
 				return;
@@ -1649,24 +2391,10 @@ RefVector<Listener> Signal::getGSlots(String name) const
 
 void Signal::emit(Event* event)
 {
-	if (_slots)
-	{
-		auto it = _slots->find(event->getName());
-		if (it != _slots->end())
-		{
-			it->second->handle(event);
-		}
-	}
-	else if (_slotsArray)
+	if (Slot* slot = getSlot(event->getId()))
 	{
-		for (auto& item : *_slotsArray)
-		{
-			if (event->getName() == item.first)
-			{
-				item.second->handle(event);
-				return;
-			}
-		}
+		Ref<Slot> slotRef(slot);
+		slotRef->handle(event);
 	}
 }
 
@@ -12,6 +12,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Support/Common.h"
 #include "Event/Event.h"
 #include "Support/Array.h"
+#include "Animation/Action.h"
 
 NS_DOROTHY_BEGIN
 
@@ -26,6 +27,59 @@ class Action;
 
 typedef Delegate<void (Event* event)> EventHandler;
 
+class Node;
+class NodePool;
+class BakedSprites;
+
+/** @brief Children of a node kept sorted by their orders.
+ Each child stores its slot index, so a removal just empties the slot
+ and an order change just marks the list unsorted. Holes are compacted and
+ the list is stable sorted again before the next ordered insertion or visit,
+ so children can be removed or reordered while they are being iterated.
+ Children with negative orders always lead the list. */
+class NodeList
+{
+public:
+	class Iterator
+	{
+	public:
+		Iterator(const Ref<Node>* it, const Ref<Node>* end):_it(it),_end(end)
+		{
+			while (_it != _end && !_it->get()) ++_it;
+		}
+		inline Node* operator*() const { return _it->get(); }
+		inline Iterator& operator++()
+		{
+			do ++_it; while (_it != _end && !_it->get());
+			return *this;
+		}
+		inline bool operator!=(const Iterator& other) const { return _it != other._it; }
+	private:
+		const Ref<Node>* _it;
+		const Ref<Node>* _end;
+	};
+	NodeList();
+	inline Iterator begin() const { return Iterator(_nodes.data(), _nodes.data() + _nodes.size()); }
+	inline Iterator end() const { return Iterator(_nodes.data() + _nodes.size(), _nodes.data() + _nodes.size()); }
+	inline bool empty() const { return _count == 0; }
+	inline Uint32 size() const { return _count; }
+	/** @brief increased on every change of the members or their order. */
+	inline Uint32 getVersion() const { return _version; }
+	/** @brief slots in order, empty slots are left by removals until compact(). */
+	inline const vector<Ref<Node>>& data() const { return _nodes; }
+	void insert(Node* node);
+	void remove(Node* node);
+	void reorder(Node* node);
+	void compact();
+	void clear();
+private:
+	vector<Ref<Node>> _nodes;
+	Uint32 _count;
+	Uint32 _holes;
+	Uint32 _version;
+	bool _unsorted;
+};
+
 class Node : public Object
 {
 public:
@@ -62,6 +116,7 @@ public:
 	PROPERTY(Object*, UserData);
 	PROPERTY_READONLY(Node*, Parent);
 	PROPERTY_READONLY(Node*, TargetParent);
+	/** @brief snapshot of the children for scripting, prefer getChildList() in C++. */
 	PROPERTY_READONLY(Array*, Children);
 	PROPERTY_READONLY_HAS(Children);
 	PROPERTY_READONLY_BOOL(Running);
@@ -75,6 +130,14 @@ public:
 	PROPERTY_VIRTUAL(int, RenderOrder);
 	PROPERTY_BOOL(RenderGroup);
 	PROPERTY_READONLY(Uint32, NodeCount);
+	/** @brief stop stepping actions on this node while it is culled out of view. */
+	PROPERTY_BOOL(PauseWhenCulled);
+	/** @brief whether this node or one of its ancestors was culled in the last visit. */
+	PROPERTY_READONLY_BOOL(Culled);
+	/** @brief render the children as sprites flattened into GPU buffers,
+	 rebuilt only when a descendant changes. Falls back to visiting the children
+	 when they contain nodes other than plain nodes and sprites. */
+	PROPERTY_BOOL(Baked);
 
 	virtual void addChild(Node* child, int order, String tag);
 	void addChild(Node* child, int order);
@@ -96,6 +159,12 @@ public:
 	virtual void cleanup() override;
 
 	Node* getChildByTag(String tag);
+	const NodeList& getChildList() const;
+
+	/** @brief copy this node tree with its properties and running actions,
+	 without the slots, scheduled functions and user data.
+	 Return nullptr when a node in the tree can not be cloned. */
+	Node* clone();
 
 	void schedule(const function<bool(double)>& func);
 	void unschedule();
@@ -118,13 +187,21 @@ public:
 	const AffineTransform& getLocalTransform();
 
 	void getLocalWorld(Matrix& localWorld);
-	virtual const Matrix& getWorld();
+	const Matrix& getWorld();
+
+	/** @brief update world matrices of the visible dirty nodes under root in one batch,
+	 computed in a flat array with SIMD and split over worker threads for large trees.
+	 Nodes left out are still updated lazily by getWorld(). */
+	static void updateWorlds(Node* root);
 
 	void markDirty();
 
 	void emit(Event* event);
+	/** @brief check for slots of an event id before building the event. */
+	bool hasSlot(Uint32 eventId) const;
 
 	Slot* slot(String name);
+	Slot* slot(Uint32 eventId, const EventHandler& handler);
 	Slot* slot(String name, const EventHandler& handler);
 	void slot(String name, std::nullptr_t);
 
@@ -145,13 +222,24 @@ public:
 		}
 	}
 
+	/** @brief emit with an id from Event::intern() to skip the name lookup. */
+	template <class ...Args>
+	void emit(Uint32 eventId, Args ...args)
+	{
+		if (hasSlot(eventId))
+		{
+			EventArgs<Args...> event(eventId, args...);
+			emit(&event);
+		}
+	}
+
 	/** @brief traverse children, return true to stop. */
 	template <class Func>
 	bool eachChild(const Func& func)
 	{
-		if (_children && !_children->isEmpty())
+		for (Node* child : _children)
 		{
-			return _children->each<Node>(func);
+			if (func(child)) return true;
 		}
 		return false;
 	}
@@ -161,11 +249,11 @@ public:
 	bool traverse(const Func& func)
 	{
 		if (func(this)) return true;
-		if (_children && _flags.isOn(Node::TraverseEnabled))
+		if (_flags.isOn(Node::TraverseEnabled))
 		{
-			for (auto child : _children->data())
+			for (Node* child : _children)
 			{
-				if (child.to<Node>()->traverse(func))
+				if (child->traverse(func))
 				{
 					return true;
 				}
@@ -179,14 +267,11 @@ public:
 	bool traverseAll(const Func& func)
 	{
 		if (func(this)) return true;
-		if (_children)
+		for (Node* child : _children)
 		{
-			for (auto child : _children->data())
+			if (child->traverseAll(func))
 			{
-				if (child.to<Node>()->traverseAll(func))
-				{
-					return true;
-				}
+				return true;
 			}
 		}
 		return false;
@@ -197,11 +282,11 @@ public:
 	bool traverseVisible(const Func& func)
 	{
 		if (!isVisible() || func(this)) return true;
-		if (_children && _flags.isOn(Node::TraverseEnabled))
+		if (_flags.isOn(Node::TraverseEnabled))
 		{
-			for (auto child : _children->data())
+			for (Node* child : _children)
 			{
-				if (child.to<Node>()->traverse(func))
+				if (child->traverse(func))
 				{
 					return true;
 				}
@@ -218,6 +303,12 @@ public:
 	void removeAction(Action* action);
 	void stopAction(Action* action);
 
+	/** @brief tween a property in the batched tweens of the node scheduler,
+	 replacing the running tween of the same property. */
+	void tween(Property::Enum prop, float duration, float start, float stop, Ease::Enum easing = Ease::Linear);
+	bool stopTween(Property::Enum prop);
+	void stopAllTweens();
+
 	Size alignItemsVertically(float padding = 10.0f);
 	Size alignItemsVertically(const Size& size, float padding = 10.0f);
 	Size alignItemsHorizontally(float padding = 10.0f);
@@ -234,7 +325,37 @@ protected:
 	virtual void updateRealColor3();
 	virtual void updateRealOpacity();
 	virtual void sortAllChildren();
-	void markParentReorder();
+	virtual void onWorldChanged();
+	/** @brief build the local transform when it is dirty, override to render
+	 with a pose other than the node position and angle. */
+	virtual void updateLocalTransform();
+	void computeLocalTransform(const Vec2& position, float angle);
+	/** @brief turn off to hide the children from traverse() and touches. */
+	void setTraverseEnabled(bool var);
+	/** @brief create a node of the same type with the type specific states copied,
+	 return nullptr when the type can not be cloned. */
+	virtual Node* cloneSelf();
+	/** @brief restore the type specific states released by cleanup(),
+	 return false when the node can not be used again. */
+	virtual bool reviveSelf();
+	/** @brief get the bounds of the rendered content in node space for view culling,
+	 return false when the content can not be bounded, which is the default
+	 for subclasses not overriding it. */
+	virtual bool getContentBounds(Rect& bounds);
+	/** @brief update the cached world bounds of the visible subtree,
+	 return false when the subtree is unbounded. */
+	bool updateBounds();
+	void markBoundsDirty();
+	void markWorldDirty();
+	/** @brief mark the ancestors to visit this subtree in updateWorlds(). */
+	void markDescendantDirty();
+	/** @brief make a cleaned up node tree usable again,
+	 return false when any node of the tree can not be revived. */
+	bool revive();
+	/** @brief tell the baked ancestors that the rendering of this node changed. */
+	void markBakeDirty();
+	void computeWorld();
+	void updateWorld();
 	void pauseActionInList(Action* action);
 	void resumeActionInList(Action* action);
 	void stopActionInList(Action* action);
@@ -258,16 +379,25 @@ protected:
 	Vec2 _anchorPoint;
 	Size _size;
 	Matrix _world;
+	AffineTransform _worldTransform;
 	AffineTransform _transform;
+	Rect _bounds;
 	WRef<Node> _transformTarget;
 	Node* _parent;
+	Uint32 _childIndex;
+	Uint32 _tweenCount;
+	bool _descendantDirty;
 	Ref<Object> _userData;
-	Ref<Array> _children;
+	NodeList _children;
+	mutable Ref<Array> _childArray;
+	mutable Uint32 _childArrayVersion;
 	Ref<Scheduler> _scheduler;
 	Ref<Action> _action;
 	Own<Signal> _signal;
 	string _tag;
 	Own<NodeTouchHandler> _touchHandler;
+	WRef<NodePool> _pool;
+	Own<BakedSprites> _bakedSprites;
 	function<bool(double)> _scheduleFunc;
 	enum
 	{
@@ -281,16 +411,31 @@ protected:
 		Scheduling = 1 << 7,
 		PassOpacity = 1 << 8,
 		PassColor3 = 1 << 9,
-		Reorder = 1 << 10,
-		Cleanup = 1 << 11,
-		TouchEnabled = 1 << 12,
-		SwallowTouches = 1 << 13,
-		SwallowMouseWheel = 1 << 14,
-		KeyboardEnabled = 1 << 15,
-		TraverseEnabled = 1 << 16,
-		RenderGrouped = 1 << 17,
-		UserFlag = 1 << 18
+		Cleanup = 1 << 10,
+		TouchEnabled = 1 << 11,
+		SwallowTouches = 1 << 12,
+		SwallowMouseWheel = 1 << 13,
+		KeyboardEnabled = 1 << 14,
+		TraverseEnabled = 1 << 15,
+		RenderGrouped = 1 << 16,
+		World3D = 1 << 17,
+		WorldMatrixDirty = 1 << 18,
+		BoundsDirty = 1 << 19,
+		ChildBoundsDirty = 1 << 20,
+		Unbounded = 1 << 21,
+		PauseWhenCulled = 1 << 22,
+		Culled = 1 << 23,
+		Baked = 1 << 24,
+		BakeDirty = 1 << 25,
+		InBake = 1 << 26,
+		UserFlag = 1 << 27
 	};
+	friend class TouchDispatcher;
+	friend class NodeList;
+	friend class NodePool;
+	friend class ClipNode;
+	friend class BakedSprites;
+	friend class TweenBatch;
 	DORA_TYPE_OVERRIDE(Node);
 };
 
@@ -313,6 +458,7 @@ private:
 class Signal
 {
 public:
+	Slot* addSlot(Uint32 eventId, const EventHandler& handler);
 	Slot* addSlot(String name, const EventHandler& handler);
 	Listener* addGSlot(String name, const EventHandler& handler);
 	void removeSlot(String name, const EventHandler& handler);
@@ -320,11 +466,13 @@ public:
 	void removeSlots(String name);
 	void removeGSlots(String name);
 	RefVector<Listener> getGSlots(String name) const;
+	bool hasSlot(Uint32 eventId) const;
 	void emit(Event* event);
 	static const size_t MaxSlotArraySize;
 private:
-	Own<unordered_map<string, Ref<Slot>>> _slots;
-	Own<vector<std::pair<string, Ref<Slot>>>> _slotsArray;
+	Slot* getSlot(Uint32 eventId) const;
+	Own<unordered_map<Uint32, Ref<Slot>>> _slots;
+	Own<vector<std::pair<Uint32, Ref<Slot>>>> _slotsArray;
 	RefVector<Listener> _gslots;
 };
 
@@ -0,0 +1,131 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#include "Const/Header.h"
+#include "Node/NodePool.h"
+#include "Node/Prefab.h"
+
+NS_DOROTHY_BEGIN
+
+NodePool::NodePool(const function<Node*()>& factory):
+_capacity(0),
+_hitCount(0),
+_missCount(0),
+_factory(factory)
+{ }
+
+NodePool::NodePool(Prefab* prefab):
+_capacity(0),
+_hitCount(0),
+_missCount(0),
+_prefab(prefab)
+{ }
+
+void NodePool::setCapacity(Uint32 var)
+{
+	_capacity = var;
+	if (_capacity > 0 && _idleNodes.size() > _capacity)
+	{
+		_idleNodes.resize(_capacity);
+	}
+}
+
+Uint32 NodePool::getCapacity() const
+{
+	return _capacity;
+}
+
+Uint32 NodePool::getIdleCount() const
+{
+	return s_cast<Uint32>(_idleNodes.size());
+}
+
+Uint32 NodePool::getHitCount() const
+{
+	return _hitCount;
+}
+
+Uint32 NodePool::getMissCount() const
+{
+	return _missCount;
+}
+
+float NodePool::getHitRate() const
+{
+	Uint32 total = _hitCount + _missCount;
+	return total > 0 ? s_cast<float>(_hitCount) / total : 0.0f;
+}
+
+Node* NodePool::createNode()
+{
+	Node* node = _prefab ? _prefab->instantiate() : _factory ? _factory() : nullptr;
+	if (node)
+	{
+		node->_pool = this;
+	}
+	return node;
+}
+
+Node* NodePool::get()
+{
+	if (_idleNodes.empty())
+	{
+		_missCount++;
+		return createNode();
+	}
+	_hitCount++;
+	Node* node = _idleNodes.back();
+	node->autoretain();
+	_idleNodes.pop_back();
+	return node;
+}
+
+void NodePool::recycle(Node* node)
+{
+	AssertIf(node == nullptr, "recycle invalid node (nullptr).");
+	AssertUnless(node->_pool.get() == this, "recycle node to a different pool.");
+	AssertIf(node->getParent(), "recycle node still added to a parent.");
+	if (node->_flags.isOff(Node::Cleanup))
+	{
+		node->cleanup();
+	}
+	if (_capacity > 0 && _idleNodes.size() >= _capacity)
+	{
+		return;
+	}
+	if (!node->revive())
+	{
+		return;
+	}
+	_idleNodes.push_back(MakeRef(node));
+}
+
+void NodePool::reserve(Uint32 count)
+{
+	_idleNodes.reserve(count);
+	while (_idleNodes.size() < count)
+	{
+		Node* node = createNode();
+		if (!node) break;
+		_idleNodes.push_back(MakeRef(node));
+	}
+}
+
+void NodePool::clear()
+{
+	_idleNodes.clear();
+}
+
+void NodePool::resetStats()
+{
+	_hitCount = 0;
+	_missCount = 0;
+}
+
+NS_DOROTHY_END
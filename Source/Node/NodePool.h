@@ -0,0 +1,57 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#pragma once
+
+#include "Node/Node.h"
+
+NS_DOROTHY_BEGIN
+
+class Prefab;
+
+/** @brief Keeps detached nodes of one kind for reuse.
+ Nodes got from a pool go back to it when they are removed from their
+ parents with cleanup, or when recycle() is called. Their actions,
+ schedules, slots and user data are cleared by the cleanup, other
+ states set while in use are kept and should be set again after get().
+ Nodes restore their own states with reviveSelf() when recycled, those
+ that can not be revived are dropped instead of kept. */
+class NodePool : public Object
+{
+public:
+	/** @brief max number of idle nodes kept, 0 for no limit. */
+	PROPERTY(Uint32, Capacity);
+	PROPERTY_READONLY(Uint32, IdleCount);
+	PROPERTY_READONLY(Uint32, HitCount);
+	PROPERTY_READONLY(Uint32, MissCount);
+	PROPERTY_READONLY(float, HitRate);
+	/** @brief get an idle node or create a new one. */
+	Node* get();
+	/** @brief return a node got from this pool, it is cleaned up when still active. */
+	void recycle(Node* node);
+	/** @brief create idle nodes ahead of use. */
+	void reserve(Uint32 count);
+	void clear();
+	void resetStats();
+	CREATE_FUNC(NodePool);
+protected:
+	NodePool(const function<Node*()>& factory);
+	NodePool(Prefab* prefab);
+	Node* createNode();
+private:
+	Uint32 _capacity;
+	Uint32 _hitCount;
+	Uint32 _missCount;
+	Ref<Prefab> _prefab;
+	function<Node*()> _factory;
+	vector<Ref<Node>> _idleNodes;
+	DORA_TYPE_OVERRIDE(NodePool);
+};
+
+NS_DOROTHY_END
@@ -251,19 +251,12 @@ bool ParticleNode::init()
 				sizeof(__defaultParticleTexturePng));
 		}
 	}
-	if (textureRect != Rect::zero)
+	if (textureRect == Rect::zero)
 	{
 		const bgfx::TextureInfo& info = _texture->getInfo();
-		_texLeft = textureRect.getX() / info.width;
-		_texTop = textureRect.getY() / info.height;
-		_texRight = (textureRect.getX() + textureRect.getWidth()) / info.width;
-		_texBottom = (textureRect.getY() + textureRect.getHeight()) / info.height;
-	}
-	else
-	{
-		_texRight = 1.0f;
-		_texBottom = 1.0f;
+		textureRect = Rect(0.0f, 0.0f, s_cast<float>(info.width), s_cast<float>(info.height));
 	}
+	_texture->getUV(textureRect, _texLeft, _texTop, _texRight, _texBottom);
 	return true;
 }
 
@@ -449,20 +442,17 @@ void ParticleNode::addQuad(const Particle& particle, float scale, float angleX,
 	{
 		Matrix rotate;
 		bx::mtxRotateXY(rotate, -bx::toRad(angleX), -bx::toRad(angleY));
-		Matrix transform;
-		bx::mtxMul(transform, rotate, SharedDirector.getViewProjection());
-		bx::vec4MulMtx(&quad.lt.x, &quadPos.lt.x, transform);
-		bx::vec4MulMtx(&quad.rt.x, &quadPos.rt.x, transform);
-		bx::vec4MulMtx(&quad.lb.x, &quadPos.lb.x, transform);
-		bx::vec4MulMtx(&quad.rb.x, &quadPos.rb.x, transform);
+		bx::vec4MulMtx(&quad.lt.x, &quadPos.lt.x, rotate);
+		bx::vec4MulMtx(&quad.rt.x, &quadPos.rt.x, rotate);
+		bx::vec4MulMtx(&quad.lb.x, &quadPos.lb.x, rotate);
+		bx::vec4MulMtx(&quad.rb.x, &quadPos.rb.x, rotate);
 	}
 	else
 	{
-		const Matrix& transform = SharedDirector.getViewProjection();
-		bx::vec4MulMtx(&quad.lt.x, &quadPos.lt.x, transform);
-		bx::vec4MulMtx(&quad.rt.x, &quadPos.rt.x, transform);
-		bx::vec4MulMtx(&quad.lb.x, &quadPos.lb.x, transform);
-		bx::vec4MulMtx(&quad.rb.x, &quadPos.rb.x, transform);
+		std::memcpy(&quad.lt.x, &quadPos.lt, sizeof(Vec4));
+		std::memcpy(&quad.rt.x, &quadPos.rt, sizeof(Vec4));
+		std::memcpy(&quad.lb.x, &quadPos.lb, sizeof(Vec4));
+		std::memcpy(&quad.rb.x, &quadPos.rb, sizeof(Vec4));
 	}
 	_quads.push_back(quad);
 }
@@ -595,6 +585,13 @@ bool ParticleNode::update(double deltaTime)
 	return Node::update(deltaTime);
 }
 
+bool ParticleNode::getContentBounds(Rect& bounds)
+{
+	/* particles are emitted in world space and simulated in visit */
+	bounds = Rect::zero;
+	return false;
+}
+
 void ParticleNode::render()
 {
 	if (_quads.empty())
@@ -122,6 +122,7 @@ public:
 protected:
 	ParticleNode(ParticleDef* def);
 	ParticleNode(String filename);
+	virtual bool getContentBounds(Rect& bounds) override;
 	void addParticle();
 	void addQuad(const Particle& particle, float scale, float angleX, float angleY);
 private:
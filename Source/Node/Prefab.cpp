@@ -0,0 +1,45 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#include "Const/Header.h"
+#include "Node/Prefab.h"
+
+NS_DOROTHY_BEGIN
+
+Prefab::Prefab(Node* node):
+_node(node),
+_instanceCount(0)
+{ }
+
+bool Prefab::init()
+{
+	if (!Object::init()) return false;
+	if (!_node) return false;
+	_node = _node->clone();
+	return _node.get() != nullptr;
+}
+
+Node* Prefab::getNode() const
+{
+	return _node;
+}
+
+Uint32 Prefab::getInstanceCount() const
+{
+	return _instanceCount;
+}
+
+Node* Prefab::instantiate()
+{
+	Node* node = _node->clone();
+	if (node) _instanceCount++;
+	return node;
+}
+
+NS_DOROTHY_END
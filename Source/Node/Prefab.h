@@ -0,0 +1,37 @@
+/* Copyright (c) 2019 Jin Li, http://www.luvfight.me
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. */
+
+
+#pragma once
+
+#include "Node/Node.h"
+
+NS_DOROTHY_BEGIN
+
+/** @brief Snapshot of a constructed node tree used as a template.
+ The tree is cloned once when the prefab is created and each instance
+ is cloned again from the snapshot, so the construction logic, cache
+ lookups and scripts building the original tree are not run again.
+ Node types without clone support make the creation fail. */
+class Prefab : public Object
+{
+public:
+	PROPERTY_READONLY(Node*, Node);
+	PROPERTY_READONLY(Uint32, InstanceCount);
+	virtual bool init() override;
+	Node* instantiate();
+	CREATE_FUNC(Prefab);
+protected:
+	Prefab(Node* node);
+private:
+	Ref<Node> _node;
+	Uint32 _instanceCount;
+	DORA_TYPE_OVERRIDE(Prefab);
+};
+
+NS_DOROTHY_END
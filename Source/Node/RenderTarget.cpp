@@ -152,7 +152,6 @@ void RenderTarget::renderAfterClear(Node* target, bool clear, Color color, float
 		}
 		SharedDirector.pushViewProjection(viewProj, [&]()
 		{
-			bgfx::setViewTransform(viewId, nullptr, viewProj);
 			renderOnly(target);
 		});
 	});
@@ -228,7 +227,7 @@ void RenderTarget::saveAsync(String filename, const function<void()>& callback)
 			{
 				bgfx::destroy(textureHandle);
 			}
-			SharedAsyncThread.Process.run([data, width, height]()
+			SharedAsyncThread.run([data, width, height]()
 			{
 				unsigned error;
 				LodePNGState state;
@@ -250,7 +249,7 @@ void RenderTarget::saveAsync(String filename, const function<void()>& callback)
 					::free(out);
 					callback();
 				});
-			});
+			}, AsyncPriority::Low);
 			return true;
 		}
 		return false;
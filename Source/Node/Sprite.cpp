@@ -21,6 +21,9 @@ NS_DOROTHY_BEGIN
 bgfx::VertexDecl SpriteVertex::ms_decl;
 SpriteVertex::Init SpriteVertex::init;
 
+bgfx::VertexDecl SpriteVertex2D::ms_decl;
+SpriteVertex2D::Init SpriteVertex2D::init;
+
 Sprite::Sprite():
 _filter(TextureFilter::None),
 _uwrap(TextureWrap::None),
@@ -71,6 +74,7 @@ bool Sprite::init()
 void Sprite::setEffect(SpriteEffect* var)
 {
 	_effect = var ? var : SharedSpriteRenderer.getDefaultEffect();
+	markBakeDirty();
 }
 
 SpriteEffect* Sprite::getEffect() const
@@ -94,6 +98,7 @@ void Sprite::setTexture(Texture2D* var)
 {
 	_texture = var;
 	updateVertTexCoord();
+	markBoundsDirty();
 }
 
 Texture2D* Sprite::getTexture() const
@@ -104,6 +109,7 @@ Texture2D* Sprite::getTexture() const
 void Sprite::setAlphaRef(float var)
 {
 	_alphaRef = s_cast<Uint8>(255.0f * Math::clamp(var, 0.0f, 1.0f));
+	markBakeDirty();
 }
 
 float Sprite::getAlphaRef() const
@@ -114,6 +120,7 @@ float Sprite::getAlphaRef() const
 void Sprite::setBlendFunc(const BlendFunc& var)
 {
 	_blendFunc = var;
+	markBakeDirty();
 }
 
 const BlendFunc& Sprite::getBlendFunc() const
@@ -124,6 +131,7 @@ const BlendFunc& Sprite::getBlendFunc() const
 void Sprite::setDepthWrite(bool var)
 {
 	_flags.set(Sprite::DepthWrite, var);
+	markBakeDirty();
 }
 
 bool Sprite::isDepthWrite() const
@@ -209,6 +217,7 @@ Uint64 Sprite::getTextureFlags() const
 void Sprite::setFilter(TextureFilter var)
 {
 	_filter = var;
+	markBakeDirty();
 }
 
 TextureFilter Sprite::getFilter() const
@@ -219,6 +228,7 @@ TextureFilter Sprite::getFilter() const
 void Sprite::setUWrap(TextureWrap var)
 {
 	_uwrap = var;
+	markBakeDirty();
 }
 
 TextureWrap Sprite::getUWrap() const
@@ -229,6 +239,7 @@ TextureWrap Sprite::getUWrap() const
 void Sprite::setVWrap(TextureWrap var)
 {
 	_vwrap = var;
+	markBakeDirty();
 }
 
 TextureWrap Sprite::getVWrap() const
@@ -240,11 +251,8 @@ void Sprite::updateVertTexCoord()
 {
 	if (_texture)
 	{
-		const bgfx::TextureInfo& info = _texture->getInfo();
-		float left = _textureRect.getX() / info.width;
-		float top = _textureRect.getY() / info.height;
-		float right = (_textureRect.getX() + _textureRect.getWidth()) / info.width;
-		float bottom = (_textureRect.getY() + _textureRect.getHeight()) / info.height;
+		float left, top, right, bottom;
+		_texture->getUV(_textureRect, left, top, right, bottom);
 		_quad.lt.u = left;
 		_quad.lt.v = top;
 		_quad.rt.u = right;
@@ -273,6 +281,7 @@ void Sprite::updateVertPosition()
 		_quadPos.rb.y = bottom;
 		_flags.setOn(Sprite::VertexPosDirty);
 	}
+	markBoundsDirty();
 }
 
 void Sprite::updateVertColor()
@@ -299,13 +308,47 @@ void Sprite::updateRealOpacity()
 	_flags.setOn(Sprite::VertexColorDirty);
 }
 
-const Matrix& Sprite::getWorld()
+void Sprite::onWorldChanged()
+{
+	_flags.setOn(Sprite::VertexPosDirty);
+}
+
+Node* Sprite::cloneSelf()
+{
+	Sprite* sprite = Sprite::create(_texture.get(), _textureRect);
+	sprite->_alphaRef = _alphaRef;
+	sprite->_filter = _filter;
+	sprite->_uwrap = _uwrap;
+	sprite->_vwrap = _vwrap;
+	sprite->_effect = _effect;
+	sprite->_quadPos = _quadPos;
+	sprite->_quad = _quad;
+	sprite->_blendFunc = _blendFunc;
+	sprite->_renderState = _renderState;
+	return sprite;
+}
+
+bool Sprite::getContentBounds(Rect& bounds)
 {
-	if (_flags.isOn(Node::WorldDirty))
+	if (!_texture || _textureRect.size == Size::zero)
 	{
-		_flags.setOn(Sprite::VertexPosDirty);
+		bounds = Rect::zero;
+	}
+	else bounds = Rect(Vec2::zero, _textureRect.size);
+	return true;
+}
+
+Uint64 Sprite::calcRenderState() const
+{
+	Uint64 state = (
+		BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A |
+		BGFX_STATE_ALPHA_REF(_alphaRef) |
+		BGFX_STATE_MSAA | _blendFunc.toValue());
+	if (_flags.isOn(Sprite::DepthWrite))
+	{
+		state |= BGFX_STATE_DEPTH_TEST_LESS;
 	}
-	return Node::getWorld();
+	return state;
 }
 
 void Sprite::render()
@@ -321,22 +364,14 @@ void Sprite::render()
 	if (_flags.isOn(Sprite::VertexPosDirty))
 	{
 		_flags.setOff(Sprite::VertexPosDirty);
-		Matrix transform;
-		bx::mtxMul(transform, _world, SharedDirector.getViewProjection());
+		const Matrix& transform = getWorld();
 		bx::vec4MulMtx(&_quad.lt.x, _quadPos.lt, transform);
 		bx::vec4MulMtx(&_quad.rt.x, _quadPos.rt, transform);
 		bx::vec4MulMtx(&_quad.lb.x, _quadPos.lb, transform);
 		bx::vec4MulMtx(&_quad.rb.x, _quadPos.rb, transform);
 	}
 
-	_renderState = (
-		BGFX_STATE_WRITE_RGB | BGFX_STATE_WRITE_A |
-		BGFX_STATE_ALPHA_REF(_alphaRef) |
-		BGFX_STATE_MSAA | _blendFunc.toValue());
-	if (_flags.isOn(Sprite::DepthWrite))
-	{
-		_renderState |= BGFX_STATE_DEPTH_TEST_LESS;
-	}
+	_renderState = calcRenderState();
 
 	SharedRendererManager.setCurrent(SharedSpriteRenderer.getTarget());
 	SharedSpriteRenderer.push(this);
@@ -344,17 +379,82 @@ void Sprite::render()
 
 /* SpriteRenderer */
 
+/* textures packed into the same atlas page share one handle and can be drawn in one batch */
+static inline bool isSameTexture(Texture2D* a, Texture2D* b)
+{
+	return a == b || (a && b && a->getHandle().idx == b->getHandle().idx);
+}
+
+static inline bool isFlatVertices(const SpriteVertex* verts, Uint32 size)
+{
+	for (Uint32 i = 0; i < size; i++)
+	{
+		const SpriteVertex& vert = verts[i];
+		if (vert.z != 0.0f || vert.w != 1.0f ||
+			vert.u < 0.0f || vert.u > 1.0f || vert.v < 0.0f || vert.v > 1.0f)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+static inline int16_t packUnorm15(float value)
+{
+	return s_cast<int16_t>(value * 32767.0f + 0.5f);
+}
+
+const Uint32 SpriteRenderer::MaxQuadCount = (UINT16_MAX + 1) / 4;
+
 SpriteRenderer::SpriteRenderer():
-_spriteIndices{0, 1, 2, 1, 3, 2},
-_lastEffect(nullptr),
+_defaultEffect(SpriteEffect::create("builtin::vs_sprite"_slice, "builtin::fs_sprite"_slice)),
+_defaultModelEffect(SpriteEffect::create("builtin::vs_spritemodel"_slice, "builtin::fs_sprite"_slice)),
+_alphaTestEffect(SpriteEffect::create("builtin::vs_sprite"_slice, "builtin::fs_spritealphatest"_slice)),
+_modelWorld(nullptr),
 _lastTexture(nullptr),
+_lastEffect(nullptr),
 _lastState(0),
 _lastFlags(UINT32_MAX),
-_defaultEffect(SpriteEffect::create("builtin::vs_sprite"_slice, "builtin::fs_sprite"_slice)),
-_defaultModelEffect(SpriteEffect::create("builtin::vs_spritemodel"_slice, "builtin::fs_sprite"_slice)),
-_alphaTestEffect(SpriteEffect::create("builtin::vs_sprite"_slice, "builtin::fs_spritealphatest"_slice))
+_compactVertex(false),
+_compactable(true),
+_quadIndexBuffer(BGFX_INVALID_HANDLE)
 { }
 
+SpriteRenderer::~SpriteRenderer()
+{
+	if (bgfx::isValid(_quadIndexBuffer)) bgfx::destroy(_quadIndexBuffer);
+}
+
+bgfx::IndexBufferHandle SpriteRenderer::getQuadIndexBuffer()
+{
+	if (!bgfx::isValid(_quadIndexBuffer))
+	{
+		const uint16_t quadIndices[] = {0, 1, 2, 1, 3, 2};
+		const bgfx::Memory* mem = bgfx::alloc(MaxQuadCount * 6 * sizeof(uint16_t));
+		uint16_t* indices = r_cast<uint16_t*>(mem->data);
+		for (Uint32 i = 0; i < MaxQuadCount; i++)
+		{
+			for (Uint32 j = 0; j < 6; j++)
+			{
+				indices[i * 6 + j] = s_cast<uint16_t>(quadIndices[j] + i * 4);
+			}
+		}
+		_quadIndexBuffer = bgfx::createIndexBuffer(mem);
+	}
+	return _quadIndexBuffer;
+}
+
+void SpriteRenderer::setCompactVertex(bool var)
+{
+	render();
+	_compactVertex = var;
+}
+
+bool SpriteRenderer::isCompactVertex() const
+{
+	return _compactVertex;
+}
+
 SpriteEffect* SpriteRenderer::getDefaultEffect() const
 {
 	return _defaultEffect;
@@ -374,37 +474,78 @@ void SpriteRenderer::render()
 {
 	if (!_vertices.empty())
 	{
-		bgfx::TransientVertexBuffer vertexBuffer;
-		bgfx::TransientIndexBuffer indexBuffer;
-		Uint32 vertexCount = s_cast<Uint32>(_vertices.size());
-		Uint32 spriteCount = vertexCount >> 2;
-		Uint32 indexCount = spriteCount * 6;
-		if (bgfx::allocTransientBuffers(
-			&vertexBuffer, SpriteVertex::ms_decl, vertexCount,
-			&indexBuffer, indexCount))
+		/* vertices are kept in world space, the view projection
+		 is applied per draw call by u_modelViewProj */
+		const Matrix& viewProj = SharedDirector.getViewProjection();
+		Matrix transform;
+		if (_modelWorld)
 		{
-			Renderer::render();
-			std::memcpy(vertexBuffer.data, _vertices.data(), _vertices.size() * sizeof(_vertices[0]));
-			uint16_t* indices = r_cast<uint16_t*>(indexBuffer.data);
-			for (size_t i = 0; i < spriteCount; i++)
+			bx::mtxMul(transform, *_modelWorld, viewProj);
+		}
+		bgfx::IndexBufferHandle indexBuffer = getQuadIndexBuffer();
+		bgfx::ViewId viewId = SharedView.getId();
+		Uint32 spriteCount = s_cast<Uint32>(_vertices.size() >> 2);
+		bool compact = _compactVertex && _compactable && !_modelWorld && bgfx::isValid(_lastEffect->getWorldProgram());
+		const bgfx::VertexDecl& decl = compact ? SpriteVertex2D::ms_decl : SpriteVertex::ms_decl;
+		/* split the batch to fit the quad index buffer and the transient buffer space left */
+		for (Uint32 start = 0; start < spriteCount;)
+		{
+			Uint32 count = std::min(spriteCount - start, MaxQuadCount);
+			count = std::min(count, bgfx::getAvailTransientVertexBuffer(count * 4, decl) >> 2);
+			if (count == 0)
+			{
+				Warn("not enough transient buffer for {} vertices, {} sprites are not drawn.", (spriteCount - start) * 4, spriteCount - start);
+				break;
+			}
+			bgfx::TransientVertexBuffer vertexBuffer;
+			bgfx::allocTransientVertexBuffer(&vertexBuffer, count * 4, decl);
+			const SpriteVertex* source = _vertices.data() + start * 4;
+			bgfx::ProgramHandle program = _lastEffect->getWorldProgram();
+			if (_modelWorld)
 			{
-				for (size_t j = 0; j < 6; j++)
+				std::memcpy(vertexBuffer.data, source, count * 4 * sizeof(SpriteVertex));
+				bgfx::setTransform(transform);
+				program = _lastEffect->apply();
+			}
+			else if (bgfx::isValid(program))
+			{
+				if (compact)
+				{
+					SpriteVertex2D* verts = r_cast<SpriteVertex2D*>(vertexBuffer.data);
+					for (Uint32 i = 0; i < count * 4; i++)
+					{
+						const SpriteVertex& vert = source[i];
+						verts[i] = {vert.x, vert.y, packUnorm15(vert.u), packUnorm15(vert.v), vert.abgr};
+					}
+				}
+				else
+				{
+					std::memcpy(vertexBuffer.data, source, count * 4 * sizeof(SpriteVertex));
+				}
+				bgfx::setTransform(viewProj);
+				_lastEffect->apply();
+			}
+			else
+			{
+				/* custom vertex shaders expect clip space positions */
+				SpriteVertex* verts = r_cast<SpriteVertex*>(vertexBuffer.data);
+				for (Uint32 i = 0; i < count * 4; i++)
 				{
-					indices[i * 6 + j] = s_cast<uint16_t>(_spriteIndices[j] + i * 4);
+					verts[i] = source[i];
+					bx::vec4MulMtx(&verts[i].x, &source[i].x, viewProj);
 				}
+				program = _lastEffect->apply();
 			}
+			Renderer::render();
 			bgfx::setVertexBuffer(0, &vertexBuffer);
-			bgfx::setIndexBuffer(&indexBuffer);
-			bgfx::ViewId viewId = SharedView.getId();
+			bgfx::setIndexBuffer(indexBuffer, 0, count * 6);
 			bgfx::setState(_lastState);
 			bgfx::setTexture(0, _lastEffect->getSampler(), _lastTexture->getHandle(), _lastFlags);
-			bgfx::submit(viewId, _lastEffect->apply());
-		}
-		else
-		{
-			Warn("not enough transient buffer for {} vertices, {} indices.", vertexCount, indexCount);
+			bgfx::submit(viewId, program);
+			start += count;
 		}
 		_vertices.clear();
+		_compactable = true;
 		_lastEffect = nullptr;
 		_lastTexture = nullptr;
 		_lastState = 0;
@@ -418,7 +559,7 @@ void SpriteRenderer::push(Sprite* sprite)
 	Texture2D* texture = sprite->getTexture();
 	Uint64 state = sprite->getRenderState();
 	Uint32 flags = sprite->getSamplerFlags();
-	if (effect != _lastEffect || texture != _lastTexture || state != _lastState || flags != _lastFlags)
+	if (effect != _lastEffect || !isSameTexture(texture, _lastTexture) || state != _lastState || flags != _lastFlags)
 	{
 		render();
 	}
@@ -429,6 +570,10 @@ void SpriteRenderer::push(Sprite* sprite)
 	_lastFlags = flags;
 
 	const SpriteVertex* verts = sprite->getQuad();
+	if (_compactVertex && _compactable)
+	{
+		_compactable = isFlatVertices(verts, 4);
+	}
 	size_t oldSize = _vertices.size();
 	_vertices.resize(oldSize + 4);
 	std::memcpy(_vertices.data() + oldSize, verts, sizeof(verts[0]) * 4);
@@ -439,7 +584,7 @@ void SpriteRenderer::push(SpriteVertex* verts, Uint32 size,
 	const Matrix* modelWorld)
 {
 	AssertUnless(size % 4 == 0, "invalid sprite vertices size.");
-	if (modelWorld || effect != _lastEffect || texture != _lastTexture || state != _lastState || flags != _lastFlags)
+	if (modelWorld || effect != _lastEffect || !isSameTexture(texture, _lastTexture) || state != _lastState || flags != _lastFlags)
 	{
 		render();
 	}
@@ -447,6 +592,10 @@ void SpriteRenderer::push(SpriteVertex* verts, Uint32 size,
 	_lastTexture = texture;
 	_lastState = state;
 	_lastFlags = flags;
+	if (_compactVertex && _compactable)
+	{
+		_compactable = isFlatVertices(verts, size);
+	}
 
 	size_t oldSize = _vertices.size();
 	_vertices.resize(oldSize + size);
@@ -454,8 +603,201 @@ void SpriteRenderer::push(SpriteVertex* verts, Uint32 size,
 
 	if (modelWorld)
 	{
-		bgfx::setTransform(modelWorld);
+		_modelWorld = modelWorld;
 		render();
+		_modelWorld = nullptr;
+	}
+}
+
+/* BakedSprites */
+
+BakedSprites::BakedSprites():
+_backCount(0),
+_vertexBuffer(BGFX_INVALID_HANDLE),
+_indexBuffer(BGFX_INVALID_HANDLE)
+{ }
+
+BakedSprites::~BakedSprites()
+{
+	if (bgfx::isValid(_vertexBuffer)) bgfx::destroy(_vertexBuffer);
+	if (bgfx::isValid(_indexBuffer)) bgfx::destroy(_indexBuffer);
+}
+
+Uint32 BakedSprites::getBackCount() const
+{
+	return _backCount;
+}
+
+Uint32 BakedSprites::getBatchCount() const
+{
+	return s_cast<Uint32>(_batches.size());
+}
+
+bool BakedSprites::build(Node* root)
+{
+	_batches.clear();
+	_vertices.clear();
+	_backCount = 0;
+	if (bgfx::isValid(_vertexBuffer))
+	{
+		bgfx::destroy(_vertexBuffer);
+		_vertexBuffer = BGFX_INVALID_HANDLE;
+	}
+	if (bgfx::isValid(_indexBuffer))
+	{
+		bgfx::destroy(_indexBuffer);
+		_indexBuffer = BGFX_INVALID_HANDLE;
+	}
+
+	Matrix rootInverse;
+	bx::mtxInverse(rootInverse, root->getWorld());
+	root->sortAllChildren();
+	bool backDone = false;
+	for (Node* child : root->_children)
+	{
+		if (!backDone && child->_order >= 0)
+		{
+			_backCount = s_cast<Uint32>(_batches.size());
+			backDone = true;
+		}
+		if (!add(child, rootInverse))
+		{
+			_batches.clear();
+			_vertices.clear();
+			return false;
+		}
+	}
+	if (!backDone)
+	{
+		_backCount = s_cast<Uint32>(_batches.size());
+	}
+	if (_vertices.empty()) return true;
+
+	Uint32 vertexCount = s_cast<Uint32>(_vertices.size());
+	Uint32 spriteCount = vertexCount / 4;
+	/* trees fitting in the shared quad index buffer use it, larger ones own 32-bit indices */
+	if (spriteCount > SpriteRenderer::MaxQuadCount)
+	{
+		const Uint32 quadIndices[] = {0, 1, 2, 1, 3, 2};
+		const bgfx::Memory* indexMem = bgfx::alloc(spriteCount * 6 * sizeof(Uint32));
+		Uint32* indices = r_cast<Uint32*>(indexMem->data);
+		for (Uint32 i = 0; i < spriteCount; i++)
+		{
+			for (Uint32 j = 0; j < 6; j++)
+			{
+				indices[i * 6 + j] = quadIndices[j] + i * 4;
+			}
+		}
+		_indexBuffer = bgfx::createIndexBuffer(indexMem, BGFX_BUFFER_INDEX32);
+	}
+	_vertexBuffer = bgfx::createVertexBuffer(
+		bgfx::copy(_vertices.data(), vertexCount * sizeof(SpriteVertex)),
+		SpriteVertex::ms_decl);
+	vector<SpriteVertex>().swap(_vertices);
+	return true;
+}
+
+bool BakedSprites::add(Node* node, const Matrix& rootInverse)
+{
+	node->_flags.setOn(Node::InBake);
+	if (node->_flags.isOff(Node::Visible)) return true;
+	if (node->_transformTarget || node->_renderOrder != 0 || node->_flags.isOn(Node::RenderGrouped))
+	{
+		return false;
+	}
+	Sprite* sprite = nullptr;
+	if (node->getDoraType() == DoraType<Sprite>())
+	{
+		sprite = s_cast<Sprite*>(node);
+		if (!sprite->_effect || !bgfx::isValid(sprite->_effect->getWorldProgram()))
+		{
+			return false;
+		}
+	}
+	else if (node->getDoraType() != DoraType<Node>())
+	{
+		return false;
+	}
+	node->updateWorld();
+	bool selfVisible = sprite && node->_flags.isOn(Node::SelfVisible);
+	if (node->_flags.isOn(Node::ChildrenVisible))
+	{
+		node->sortAllChildren();
+		for (Node* child : node->_children)
+		{
+			if (selfVisible && child->_order >= 0)
+			{
+				addSprite(sprite, rootInverse);
+				selfVisible = false;
+			}
+			if (!add(child, rootInverse)) return false;
+		}
+	}
+	if (selfVisible)
+	{
+		addSprite(sprite, rootInverse);
+	}
+	return true;
+}
+
+void BakedSprites::addSprite(Sprite* sprite, const Matrix& rootInverse)
+{
+	if (!sprite->_texture || sprite->_textureRect.size == Size::zero) return;
+
+	Matrix transform;
+	bx::mtxMul(transform, sprite->getWorld(), rootInverse);
+	SpriteQuad quad = sprite->_quad;
+	bx::vec4MulMtx(&quad.lt.x, sprite->_quadPos.lt, transform);
+	bx::vec4MulMtx(&quad.rt.x, sprite->_quadPos.rt, transform);
+	bx::vec4MulMtx(&quad.lb.x, sprite->_quadPos.lb, transform);
+	bx::vec4MulMtx(&quad.rb.x, sprite->_quadPos.rb, transform);
+	Uint32 abgr = sprite->_realColor.toABGR();
+	quad.lt.abgr = quad.rt.abgr = quad.lb.abgr = quad.rb.abgr = abgr;
+
+	SpriteEffect* effect = sprite->_effect;
+	Texture2D* texture = sprite->_texture;
+	Uint64 state = sprite->calcRenderState();
+	Uint32 flags = sprite->getSamplerFlags();
+	Uint32 startIndex = s_cast<Uint32>(_vertices.size() / 4 * 6);
+	const SpriteVertex* verts = quad;
+	_vertices.insert(_vertices.end(), verts, verts + 4);
+
+	/* batches behind the root are never merged with the ones in front */
+	if (_batches.size() > _backCount)
+	{
+		Batch& last = _batches.back();
+		if (last.effect.get() == effect && isSameTexture(last.texture.get(), texture) && last.state == state && last.flags == flags)
+		{
+			last.indexCount += 6;
+			return;
+		}
+	}
+	_batches.push_back({MakeRef(effect), MakeRef(texture), state, flags, startIndex, 6});
+}
+
+void BakedSprites::render(const Matrix& world, Uint32 begin, Uint32 end)
+{
+	if (!bgfx::isValid(_vertexBuffer)) return;
+	Matrix transform;
+	bx::mtxMul(transform, world, SharedDirector.getViewProjection());
+	Uint32 stencilState = SharedRendererManager.getCurrentStencilState();
+	bgfx::ViewId viewId = SharedView.getId();
+	bgfx::IndexBufferHandle indexBuffer = bgfx::isValid(_indexBuffer) ? _indexBuffer : SharedSpriteRenderer.getQuadIndexBuffer();
+	end = std::min(end, s_cast<Uint32>(_batches.size()));
+	for (Uint32 i = begin; i < end; i++)
+	{
+		const Batch& batch = _batches[i];
+		if (stencilState != BGFX_STENCIL_NONE)
+		{
+			bgfx::setStencil(stencilState);
+		}
+		bgfx::setTransform(transform);
+		bgfx::setVertexBuffer(0, _vertexBuffer);
+		bgfx::setIndexBuffer(indexBuffer, batch.startIndex, batch.indexCount);
+		bgfx::setState(batch.state);
+		bgfx::setTexture(0, batch.effect->getSampler(), batch.texture->getHandle(), batch.flags);
+		batch.effect->apply();
+		bgfx::submit(viewId, batch.effect->getWorldProgram());
 	}
 }
 
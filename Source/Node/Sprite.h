@@ -38,6 +38,33 @@ struct SpriteVertex
 	static Init init;
 };
 
+/** @brief Compact layout for flat sprite batches, 16 bytes against 28.
+ The shaders read a_position as (x, y, 0, 1) and the normalized 16-bit
+ texture coordinates as floats, so the builtin programs are shared.
+ Texture coordinates are limited to [0, 1] and use the positive half of Int16,
+ since this bgfx has no Uint16 attribute type. */
+struct SpriteVertex2D
+{
+	float x;
+	float y;
+	int16_t u;
+	int16_t v;
+	uint32_t abgr;
+	struct Init
+	{
+		Init()
+		{
+			ms_decl.begin()
+				.add(bgfx::Attrib::Position, 2, bgfx::AttribType::Float)
+				.add(bgfx::Attrib::TexCoord0, 2, bgfx::AttribType::Int16, true)
+				.add(bgfx::Attrib::Color0, 4, bgfx::AttribType::Uint8, true)
+			.end();
+		}
+	};
+	static bgfx::VertexDecl ms_decl;
+	static Init init;
+};
+
 struct SpriteQuad
 {
 	SpriteVertex lt;
@@ -82,16 +109,19 @@ public:
 	virtual ~Sprite();
 	virtual bool init() override;
 	virtual void render() override;
-	virtual const Matrix& getWorld() override;
 	CREATE_FUNC(Sprite);
 protected:
 	Sprite();
 	Sprite(String filename);
 	Sprite(Texture2D* texture);
+	virtual void onWorldChanged() override;
+	virtual bool getContentBounds(Rect& bounds) override;
+	virtual Node* cloneSelf() override;
 	Sprite(Texture2D* texture, const Rect& textureRect);
 	void updateVertTexCoord();
 	void updateVertPosition();
 	void updateVertColor();
+	Uint64 calcRenderState() const;
 	virtual void updateRealColor3() override;
 	virtual void updateRealOpacity() override;
 private:
@@ -112,16 +142,60 @@ private:
 		VertexPosDirty = Node::UserFlag << 1,
 		DepthWrite = Node::UserFlag << 2,
 	};
+	friend class BakedSprites;
 	DORA_TYPE_OVERRIDE(Sprite);
 };
 
+/** @brief Sprites of a static node tree flattened into persistent GPU buffers.
+ Vertices are kept in the space of the baked root, so the root can still move,
+ and quads are merged into draw calls by runs of the same effect, texture and states
+ to keep the painter order. */
+class BakedSprites
+{
+public:
+	BakedSprites();
+	~BakedSprites();
+	/** @brief number of draw calls rendered behind the root node. */
+	PROPERTY_READONLY(Uint32, BackCount);
+	PROPERTY_READONLY(Uint32, BatchCount);
+	/** @brief flatten the visible children of root,
+	 return false when there is content that can not be baked. */
+	bool build(Node* root);
+	void render(const Matrix& world, Uint32 begin, Uint32 end);
+private:
+	bool add(Node* node, const Matrix& rootInverse);
+	void addSprite(Sprite* sprite, const Matrix& rootInverse);
+	struct Batch
+	{
+		Ref<SpriteEffect> effect;
+		Ref<Texture2D> texture;
+		Uint64 state;
+		Uint32 flags;
+		Uint32 startIndex;
+		Uint32 indexCount;
+	};
+	vector<Batch> _batches;
+	vector<SpriteVertex> _vertices;
+	Uint32 _backCount;
+	bgfx::VertexBufferHandle _vertexBuffer;
+	bgfx::IndexBufferHandle _indexBuffer;
+};
+
 class SpriteRenderer : public Renderer
 {
 public:
 	PROPERTY_READONLY(SpriteEffect*, DefaultEffect);
 	PROPERTY_READONLY(SpriteEffect*, DefaultModelEffect);
 	PROPERTY_READONLY(SpriteEffect*, AlphaTestEffect);
-	virtual ~SpriteRenderer() { }
+	/** @brief quads covered by the quad index buffer, larger batches are split. */
+	static const Uint32 MaxQuadCount;
+	/** @brief static 16-bit index buffer of the 0,1,2,1,3,2 pattern for
+	 MaxQuadCount quads, shared by all the quad renderers. */
+	PROPERTY_READONLY_CALL(bgfx::IndexBufferHandle, QuadIndexBuffer);
+	/** @brief upload batches of flat quads with texture coordinates
+	 in [0, 1] as SpriteVertex2D. */
+	PROPERTY_BOOL(CompactVertex);
+	virtual ~SpriteRenderer();
 	virtual void render() override;
 	void push(Sprite* sprite);
 	void push(SpriteVertex* verts, Uint32 size,
@@ -133,12 +207,15 @@ private:
 	Ref<SpriteEffect> _defaultEffect;
 	Ref<SpriteEffect> _defaultModelEffect;
 	Ref<SpriteEffect> _alphaTestEffect;
+	const Matrix* _modelWorld;
 	Texture2D* _lastTexture;
 	SpriteEffect* _lastEffect;
 	Uint64 _lastState;
 	Uint32 _lastFlags;
 	vector<SpriteVertex> _vertices;
-	const uint16_t _spriteIndices[6];
+	bool _compactVertex;
+	bool _compactable;
+	bgfx::IndexBufferHandle _quadIndexBuffer;
 	SINGLETON_REF(SpriteRenderer, RendererManager);
 };
 
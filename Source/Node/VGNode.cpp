@@ -51,6 +51,12 @@ void VGNode::cleanup()
 	Node::cleanup();
 }
 
+bool VGNode::reviveSelf()
+{
+	/* the drawing surface is released by cleanup */
+	return false;
+}
+
 void VGNode::render(const function<void()>& func)
 {
 	VGTexture* texture = s_cast<VGTexture*>(_surface->getTexture());
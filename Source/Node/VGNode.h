@@ -24,6 +24,7 @@ public:
 	CREATE_FUNC(VGNode);
 protected:
 	VGNode(float width, float height, float scale = 1.0f, int edgeAA = 1);
+	virtual bool reviveSelf() override;
 private:
 	float _frameWidth;
 	float _frameHeight;
@@ -18,7 +18,13 @@ Body::Body(BodyDef* bodyDef, PhysicsWorld* world, const Vec2& pos, float rot):
 _prBody(nullptr),
 _bodyDef(bodyDef),
 _world(world),
-_group(0)
+_group(0),
+_lastAngle(0.0f),
+_stepAngle(0.0f),
+_lastPosition{},
+_stepPosition{},
+_renderAngle(0.0f),
+_renderPosition{}
 {
 	AssertIf(world == nullptr, "init Body with invalid PhysicsWorld.");
 	bodyDef->getConf()->UseLocation(PhysicsWorld::b2Val(pos + bodyDef->offset));
@@ -45,9 +51,17 @@ Body::~Body()
 bool Body::init()
 {
 	if (!Node::init()) return false;
+	Body::createPrBody();
+	Node::setPosition(PhysicsWorld::oVal(_bodyDef->getConf()->location));
+	_lastPosition = _stepPosition = Node::getPosition();
+	_lastAngle = _stepAngle = Node::getAngle();
+	return true;
+}
+
+void Body::createPrBody()
+{
 	_prBody = _world->getPrWorld()->CreateBody(*_bodyDef->getConf());
 	_prBody->SetUserData(r_cast<void*>(this));
-	Node::setPosition(PhysicsWorld::oVal(_bodyDef->getConf()->location));
 	for (FixtureDef& fixtureDef : _bodyDef->getFixtureConfs())
 	{
 		if (fixtureDef.conf.isSensor)
@@ -59,6 +73,25 @@ bool Body::init()
 			Body::attachFixture(&fixtureDef);
 		}
 	}
+}
+
+bool Body::reviveSelf()
+{
+	if (_prBody) return true;
+	/* cleanup destroyed the physics body and the sensors, build them
+	 again at the node pose and keep them disabled until onEnter() */
+	bool emittingEvent = isEmittingEvent();
+	Body::setEmittingEvent(false);
+	const Vec2& position = Node::getPosition();
+	float angle = Node::getAngle();
+	_bodyDef->getConf()->UseLocation(PhysicsWorld::b2Val(position));
+	_bodyDef->getConf()->UseAngle(-bx::toRad(angle));
+	Body::createPrBody();
+	_prBody->SetEnabled(false);
+	_lastPosition = _stepPosition = position;
+	_lastAngle = _stepAngle = angle;
+	resetInterpolation();
+	Body::setEmittingEvent(emittingEvent);
 	return true;
 }
 
@@ -303,20 +336,24 @@ float Body::getVelocityY() const
 
 void Body::setPosition(const Vec2& var)
 {
+	resetInterpolation();
 	if (var != Node::getPosition())
 	{
 		Node::setPosition(var);
 		_prBody->SetTransform(PhysicsWorld::b2Val(var), _prBody->GetAngle());
 	}
+	_lastPosition = _stepPosition = var;
 }
 
 void Body::setAngle(float var)
 {
+	resetInterpolation();
 	if (var != Node::getAngle())
 	{
 		Node::setAngle(var);
 		_prBody->SetTransform(_prBody->GetLocation(), -bx::toRad(var));
 	}
+	_lastAngle = _stepAngle = var;
 }
 
 Rect Body::getBoundingBox()
@@ -327,6 +364,13 @@ Rect Body::getBoundingBox()
 	return Rect(lower.x, lower.y, upper.x - lower.x, upper.y - lower.y);
 }
 
+bool Body::getContentBounds(Rect& bounds)
+{
+	/* a body draws nothing, its visuals are children */
+	bounds = Rect::zero;
+	return true;
+}
+
 void Body::setReceivingContact(bool var)
 {
 	_flags.set(Body::ReceivingContact, var);
@@ -350,22 +394,26 @@ void Body::onSensorAdded(Sensor* sensor, Body* body)
 
 void Body::onBodyEnter(Sensor* sensor, Body* other)
 {
-	emit("BodyEnter"_slice, other, sensor);
+	static const Uint32 bodyEnter = Event::intern("BodyEnter"_slice);
+	emit(bodyEnter, other, sensor);
 }
 
 void Body::onBodyLeave(Sensor* sensor, Body* other)
 {
-	emit("BodyLeave"_slice, other, sensor);
+	static const Uint32 bodyLeave = Event::intern("BodyLeave"_slice);
+	emit(bodyLeave, other, sensor);
 }
 
 void Body::onContactStart(Body* other, const Vec2& point, const Vec2& normal)
 {
-	emit("ContactStart"_slice, other, point, normal);
+	static const Uint32 contactStart = Event::intern("ContactStart"_slice);
+	emit(contactStart, other, point, normal);
 }
 
 void Body::onContactEnd(Body* other, const Vec2& point, const Vec2& normal)
 {
-	emit("ContactEnd"_slice, other, point, normal);
+	static const Uint32 contactEnd = Event::intern("ContactEnd"_slice);
+	emit(contactEnd, other, point, normal);
 }
 
 void Body::setEmittingEvent(bool var)
@@ -412,4 +460,54 @@ void Body::updatePhysics()
 	}
 }
 
+void Body::stepPhysics(bool interpolate)
+{
+	if (interpolate)
+	{
+		_lastPosition = Node::getPosition();
+		_lastAngle = Node::getAngle();
+		updatePhysics();
+		_stepPosition = Node::getPosition();
+		_stepAngle = Node::getAngle();
+	}
+	else
+	{
+		resetInterpolation();
+		updatePhysics();
+	}
+}
+
+void Body::interpolate(float alpha)
+{
+	if (_lastPosition != _stepPosition || _lastAngle != _stepAngle)
+	{
+		_flags.setOn(Body::Interpolated);
+		_renderPosition = _lastPosition + (_stepPosition - _lastPosition) * alpha;
+		/* rotate along the shorter arc */
+		float deltaAngle = std::remainder(_stepAngle - _lastAngle, 360.0f);
+		_renderAngle = _lastAngle + deltaAngle * alpha;
+		markDirty();
+	}
+	else resetInterpolation();
+}
+
+void Body::resetInterpolation()
+{
+	/* render with the stepped pose again */
+	if (_flags.isOn(Body::Interpolated))
+	{
+		_flags.setOff(Body::Interpolated);
+		markDirty();
+	}
+}
+
+void Body::updateLocalTransform()
+{
+	if (_flags.isOn(Body::Interpolated))
+	{
+		computeLocalTransform(_renderPosition, _renderAngle);
+	}
+	else Node::updateLocalTransform();
+}
+
 NS_DOROTHY_END
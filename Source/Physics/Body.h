@@ -71,15 +71,36 @@ public:
 protected:
 	Body(BodyDef* bodyDef, PhysicsWorld* world, const Vec2& pos = Vec2::zero, float rot = 0);
 	pd::Fixture* attachFixture(FixtureDef* fixtureDef);
+	/** @brief create the physics body with the fixtures and sensors of the body def. */
+	void createPrBody();
+	virtual bool getContentBounds(Rect& bounds) override;
+	virtual bool reviveSelf() override;
 	virtual void updatePhysics();
+	/**
+	 Called by PhysicsWorld after each fixed step, records the poses before
+	 and after the step for render interpolation.
+	 */
+	void stepPhysics(bool interpolate);
+	/** @brief render with a pose between the last two steps,
+	 the node position and angle keep the stepped pose. */
+	void interpolate(float alpha);
+	void resetInterpolation();
+	virtual void updateLocalTransform() override;
 	pd::Body* _prBody; // weak reference
 	PhysicsWorld* _world;
 	Uint8 _group;
+	float _lastAngle;
+	float _stepAngle;
+	Vec2 _lastPosition;
+	Vec2 _stepPosition;
+	float _renderAngle;
+	Vec2 _renderPosition;
 	enum
 	{
 		ReceivingContact = UserFlag,
 		EmittingEvent = UserFlag << 1,
-		BodyUserFlag = UserFlag << 2
+		Interpolated = UserFlag << 2,
+		BodyUserFlag = UserFlag << 3
 	};
 	void onSensorAdded(Sensor* sensor, Body* body);
 	void onBodyEnter(Sensor* sensor, Body* other);
@@ -13,6 +13,8 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #include "Physics/Joint.h"
 #include "Physics/DebugDraw.h"
 #include "Node/DrawNode.h"
+#include "Basic/Director.h"
+#include "Basic/Scheduler.h"
 
 NS_DOROTHY_BEGIN
 
@@ -47,7 +49,8 @@ float PhysicsWorld::b2Factor = 100.0f;
 PhysicsWorld::PhysicsWorld():
 _world{},
 _contactListner(new ContactListener()),
-_destructionListener(new DestructionListener())
+_destructionListener(new DestructionListener()),
+_interpolation(Scheduler::InvalidHandle)
 {
 	_stepConf.regVelocityIterations = 1;
 	_stepConf.regPositionIterations = 1;
@@ -78,6 +81,8 @@ bool PhysicsWorld::init()
 		_filters[i].categoryBits = 1<<i;
 		_filters[i].maskBits = 0;
 	}
+	_flags.setOn(PhysicsWorld::Interpolation);
+	Node::setScheduler(SharedDirector.getFixedScheduler());
 	Node::scheduleUpdate();
 	return true;
 }
@@ -90,6 +95,13 @@ void PhysicsWorld::render()
 	}
 }
 
+bool PhysicsWorld::getContentBounds(Rect& bounds)
+{
+	/* debug shapes are drawn into the renderer child every frame */
+	bounds = Rect::zero;
+	return !_debugDraw;
+}
+
 pd::World* PhysicsWorld::getPrWorld() const
 {
 	return c_cast<pd::World*>(&_world);
@@ -103,12 +115,14 @@ void PhysicsWorld::setShowDebug(bool var)
 		{
 			_debugDraw = New<DebugDraw>();
 			addChild(_debugDraw->getRenderer(), INT_MAX, "DebugDraw"_slice);
+			markBoundsDirty();
 		}
 	}
 	else if (_debugDraw)
 	{
 		removeChild(_debugDraw->getRenderer());
 		_debugDraw = nullptr;
+		markBoundsDirty();
 	}
 }
 
@@ -117,6 +131,22 @@ bool PhysicsWorld::isShowDebug() const
 	return _debugDraw != nullptr;
 }
 
+void PhysicsWorld::setInterpolation(bool var)
+{
+	_flags.set(PhysicsWorld::Interpolation, var);
+}
+
+bool PhysicsWorld::isInterpolation() const
+{
+	return _flags.isOn(PhysicsWorld::Interpolation);
+}
+
+bool PhysicsWorld::isInterpolating() const
+{
+	return _flags.isOn(PhysicsWorld::Interpolation) &&
+		_scheduler == SharedDirector.getFixedScheduler();
+}
+
 void PhysicsWorld::setIterations(int velocityIter, int positionIter)
 {
 	_stepConf.regVelocityIterations = velocityIter;
@@ -129,12 +159,13 @@ bool PhysicsWorld::update(double deltaTime)
 	{
 		_stepConf.SetTime(s_cast<pr::Time>(deltaTime));
 		_world.Step(_stepConf);
+		bool interpolating = isInterpolating();
 		for (pd::Body* b : _world.GetBodies())
 		{
 			if (b->IsEnabled())
 			{
 				Body* body = r_cast<Body*>(b->GetUserData());
-				body->updatePhysics();
+				body->stepPhysics(interpolating);
 			}
 		}
 		_contactListner->SolveContacts();
@@ -143,6 +174,37 @@ bool PhysicsWorld::update(double deltaTime)
 	return !isUpdating() && result;
 }
 
+void PhysicsWorld::onEnter()
+{
+	Node::onEnter();
+	_interpolation = SharedDirector.getPostScheduler()->schedule([this](double)
+	{
+		interpolate();
+		return false;
+	});
+}
+
+void PhysicsWorld::onExit()
+{
+	SharedDirector.getPostScheduler()->unschedule(_interpolation);
+	_interpolation = Scheduler::InvalidHandle;
+	Node::onExit();
+}
+
+void PhysicsWorld::interpolate()
+{
+	if (!isInterpolating()) return;
+	float alpha = SharedDirector.getFixedAlpha();
+	for (pd::Body* b : _world.GetBodies())
+	{
+		if (b->IsEnabled())
+		{
+			Body* body = r_cast<Body*>(b->GetUserData());
+			body->interpolate(alpha);
+		}
+	}
+}
+
 bool PhysicsWorld::query(const Rect& rect, const function<bool(Body*)>& callback)
 {
 	pd::AABB aabb{
@@ -9,6 +9,7 @@ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLI
 #pragma once
 
 #include "Node/Node.h"
+#include "Basic/Scheduler.h"
 #include "PlayRho/Collision/RayCastOutput.hpp"
 
 namespace playrho {
@@ -90,6 +91,12 @@ public:
 	virtual ~PhysicsWorld();
 	PROPERTY_READONLY(pd::World*, PrWorld);
 	PROPERTY_BOOL(ShowDebug);
+	/**
+	 Physics world is updated by Director`s fixed scheduler by default.
+	 With interpolation on, bodies are rendered between their last two
+	 fixed step poses to keep motion smooth at any frame rate.
+	 */
+	PROPERTY_BOOL(Interpolation);
 	/**
 	 Iterations affect PlayRho`s CPU cost greatly.
 	 Lower these values to get better performance, higher values to get better simulation.
@@ -104,6 +111,8 @@ public:
 
 	virtual bool init() override;
 	virtual bool update(double deltaTime) override;
+	virtual void onEnter() override;
+	virtual void onExit() override;
 	virtual void render() override;
 	/**
 	 Use this rect query at any time without worrying Box2D`s callback limits.
@@ -131,6 +140,16 @@ public:
 	CREATE_FUNC(PhysicsWorld);
 protected:
 	PhysicsWorld();
+	bool isInterpolating() const;
+	/** @brief move the bodies to their render poses between the last two fixed
+	 steps, run by the post scheduler before the world matrices are updated. */
+	void interpolate();
+	virtual bool getContentBounds(Rect& bounds) override;
+	enum
+	{
+		Interpolation = Node::UserFlag,
+		PhysicsUserFlag = Node::UserFlag << 1
+	};
 private:
 	vector<Body*> _queryResultsOfCommonShapes;
 	vector<Body*> _queryResultsOfChainsAndEdges;
@@ -151,6 +170,7 @@ private:
 	pr::StepConf _stepConf;
 	Own<ContactListener> _contactListner;
 	Own<DestructionListener> _destructionListener;
+	Scheduler::Handle _interpolation;
 	DORA_TYPE_OVERRIDE(PhysicsWorld);
 };
 
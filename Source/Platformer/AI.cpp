@@ -130,9 +130,21 @@ bool AI::runDecisionTree(Unit* unit)
 		}
 		else if (!_decisionNodes.empty())
 		{
-			_self->getEntity()->set("decisionTrace"_slice,
-				std::accumulate(_decisionNodes.begin()+1, _decisionNodes.end(), _decisionNodes.front().toString(),
-				[](const string& a, String b) { return a + " -> " + b; }));
+			/* the trace is stored in entity and outlives the frame,
+			 so build it in one string instead of frame memory */
+			size_t size = 0;
+			for (const auto& node : _decisionNodes)
+			{
+				size += node.size() + 4;
+			}
+			string trace;
+			trace.reserve(size);
+			for (const auto& node : _decisionNodes)
+			{
+				if (&node != &_decisionNodes.front()) trace.append(" -> ");
+				trace.append(node.rawData(), node.size());
+			}
+			_self->getEntity()->set("decisionTrace"_slice, trace);
 			_decisionNodes.clear();
 		}
 	}
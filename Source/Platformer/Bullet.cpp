@@ -59,6 +59,8 @@ bool Bullet::init()
 	{
 		Bullet::setAngle(-bx::toDeg(std::atan2(v.y, _owner->isFaceRight() ? v.x : -v.x)));
 	}
+	// update in step with the physics world
+	Node::setScheduler(_world->getScheduler());
 	this->scheduleUpdate();
 	return true;
 }
@@ -80,6 +82,12 @@ void Bullet::updatePhysics()
 	}
 }
 
+bool Bullet::reviveSelf()
+{
+	/* the update and the contact handlers set up by init() are gone */
+	return false;
+}
+
 bool Bullet::update(double deltaTime)
 {
 	if (getGroup() == SharedData.getGroupHide()) return true;
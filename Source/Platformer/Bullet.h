@@ -40,6 +40,7 @@ public:
 protected:
 	Bullet(BulletDef* def, Unit* unit);
 	virtual void updatePhysics() override;
+	virtual bool reviveSelf() override;
 private:
 	enum
 	{
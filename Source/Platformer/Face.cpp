@@ -137,9 +137,9 @@ Node* Face::toNode() const
 				}
 			};
 			self->slot("__Stoped"_slice, callback);
-			if (self->getChildren() && !self->getChildren()->isEmpty())
+			if (self->hasChildren())
 			{
-				ARRAY_START(Node, child, self->getChildren())
+				for (Node* child : self->getChildList())
 				{
 					if (child->getTag() == "_F"_slice)
 					{
@@ -147,7 +147,6 @@ Node* Face::toNode() const
 						child->emit("Stop"_slice);
 					}
 				}
-				ARRAY_END
 			}
 		}
 	});
@@ -22,7 +22,7 @@ void PlatformWorld::Layer::setIndex(int var)
 	if (_index != var)
 	{
 		_index = var;
-		markParentReorder();
+		Node::setOrder(var);
 	}
 }
 
@@ -44,11 +44,6 @@ const Vec2& PlatformWorld::Layer::getOffset() const
 	return _offset;
 }
 
-void PlatformWorld::Layer::sortAllChildren()
-{
-	Node::sortAllChildren();
-}
-
 /* PlatformWorld */
 
 void PlatformWorld::addChild(Node* child, int order, String tag)
@@ -145,21 +140,6 @@ void PlatformWorld::onExit()
 	Node::onExit();
 }
 
-void PlatformWorld::sortAllChildren()
-{
-	if (_flags.isOn(Node::Reorder))
-	{
-		RefVector<Object>& data = _children->data();
-		std::stable_sort(data.begin(), data.end(), [](const Ref<>& a, const Ref<>& b)
-		{
-			int orderA = a.to<Layer>() ? a.to<Layer>()->getIndex() : a.to<Node>()->getOrder();
-			int orderB = b.to<Layer>() ? b.to<Layer>()->getIndex() : b.to<Node>()->getOrder();
-			return orderA < orderB;
-		});
-		_flags.setOff(Node::Reorder);
-	}
-}
-
 void PlatformWorld::moveChild(Node* child, int newOrder)
 {
 	Layer* layer = DoraCast<Layer>(child->getParent());
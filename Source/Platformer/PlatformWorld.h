@@ -36,7 +36,7 @@ public:
 	void onCameraMoved(float deltaX, float deltaY);
 	CREATE_FUNC(PlatformWorld);
 protected:
-	virtual void sortAllChildren() override;
+	/* layers are kept in the children list with their indices as orders */
 	class Layer : public Node
 	{
 	public:
@@ -45,8 +45,12 @@ protected:
 		PROPERTY(int, Index);
 		CREATE_FUNC(Layer);
 	protected:
-		Layer():_offset{},ratio{} { }
-		virtual void sortAllChildren() override;
+		Layer():ratio{},_index(0),_offset{} { }
+		virtual bool getContentBounds(Rect& bounds) override
+		{
+			bounds = Rect::zero;
+			return true;
+		}
 	private:
 		int _index;
 		Vec2 _offset;
@@ -85,6 +85,8 @@ bool Unit::init()
 	{
 		_entity->set("hp"_slice, s_cast<double>(_unitDef->maxHp));
 	}
+	// update in step with the physics world
+	Node::setScheduler(_world->getScheduler());
 	this->scheduleUpdate();
 	return true;
 }
@@ -183,6 +185,12 @@ void Unit::cleanup()
 	Body::cleanup();
 }
 
+bool Unit::reviveSelf()
+{
+	/* the entity, the unit def and the actions are released by cleanup */
+	return false;
+}
+
 void Unit::setGroup(Uint8 group)
 {
 	_group = group;
@@ -88,6 +88,7 @@ public:
 protected:
 	Unit(UnitDef* unitDef, PhysicsWorld* physicsWorld, Entity* entity, const Vec2& pos, float rot);
 	Unit(String defName, String worldName, Entity* entity, const Vec2& pos, float rot);
+	virtual bool reviveSelf() override;
 private:
 	WRef<Entity> _entity;
 	float _detectDistance;
@@ -142,7 +142,7 @@ Color Color::Black(0x0);
 
 const BlendFunc BlendFunc::Default{BlendFunc::SrcAlpha, BlendFunc::InvSrcAlpha};
 
-Uint64 BlendFunc::toValue()
+Uint64 BlendFunc::toValue() const
 {
 	return BGFX_STATE_BLEND_FUNC(src, dst);
 }
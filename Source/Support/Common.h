@@ -66,7 +66,7 @@ struct BlendFunc
 		InvDstColor = Uint32(BGFX_STATE_BLEND_INV_DST_COLOR),
 		InvDstAlpha = Uint32(BGFX_STATE_BLEND_INV_DST_ALPHA)
 	};
-	Uint64 toValue();
+	Uint64 toValue() const;
 	static const BlendFunc Default;
 };
 
@@ -102,7 +102,10 @@ class Application
 	tolua_readonly tolua_property__common float deviceRatio;
 	tolua_readonly tolua_property__common String platform;
 	tolua_readonly tolua_property__common double eclapsedTime;
+	tolua_readonly tolua_property__common double frameJitter;
 	tolua_readonly tolua_property__common Uint32 rand;
+	tolua_readonly tolua_property__bool bool headless;
+	tolua_property__common double fixedFrameTime;
 	tolua_property__common unsigned int seed;
 	void shutdown();
 	static tolua_outside Application* Application_shared @ create();
@@ -205,12 +208,21 @@ class Listener @ GSlot : public
 class Scheduler : public Object
 {
 	tolua_property__common float timeScale;
-	void schedule(Object* object);
-	void schedule(tolua_handler handler);
+	tolua_readonly tolua_property__common Uint32 scheduledCount;
+	void schedule(Object* object, int priority = 0);
+	void schedule(tolua_handler handler, int priority = 0);
 	void unschedule(Object* object);
 	static Scheduler* create();
 };
 
+class Timer : public Object
+{
+	tolua_readonly tolua_property__bool bool running;
+	void start(float duration, tolua_function_void callback);
+	void stop();
+	static Timer* create();
+};
+
 class Camera : public Object
 {
 	tolua_readonly tolua_property__common string name;
@@ -240,6 +252,11 @@ class Director
 	tolua_readonly tolua_property__common Node* postNode;
 	tolua_readonly tolua_property__common Scheduler* systemScheduler;
 	tolua_readonly tolua_property__common Scheduler* postScheduler;
+	tolua_readonly tolua_property__common Scheduler* fixedScheduler;
+	tolua_property__common Uint32 fixedFPS;
+	tolua_property__common Uint32 maxFixedSteps;
+	tolua_readonly tolua_property__common double fixedDeltaTime;
+	tolua_readonly tolua_property__common float fixedAlpha;
 	tolua_readonly tolua_property__common Camera* currentCamera;
 	tolua_readonly tolua_property__common double deltaTime;
 	void pushCamera(Camera* camera);
@@ -263,6 +280,18 @@ class View
 	static tolua_outside View* View_shared @ create();
 }
 
+class FrameProfiler
+{
+	tolua_property__bool bool enabled;
+	tolua_property__common Uint32 capacity;
+	tolua_readonly tolua_property__common Uint32 count;
+	void push(String name);
+	void pop();
+	void clear();
+	void dumpTrace @ dump(String filename);
+	static tolua_outside FrameProfiler* FrameProfiler_shared @ create();
+};
+
 void Dora_Log @ Log(String msg);
 
 class Slot : public Object
@@ -327,6 +356,9 @@ class Node : public Object
 	tolua_property__bool bool keyboardEnabled;
 	tolua_property__bool bool renderGroup;
 	tolua_property__common int renderOrder;
+	tolua_property__bool bool pauseWhenCulled;
+	tolua_readonly tolua_property__bool bool culled;
+	tolua_property__bool bool baked;
 
 	void addChild(Node* child, int order, String tag);
 	void addChild(Node* child, int order);
@@ -344,6 +376,7 @@ class Node : public Object
 	void cleanup();
 
 	Node* getChildByTag(String tag);
+	Node* clone();
 
 	void schedule(tolua_function_bool func);
 	void unschedule();
@@ -364,6 +397,10 @@ class Node : public Object
 	void perform(Action* action);
 	void stopAction(Action* action);
 
+	tolua_outside void Node_tween @ tween(String name, float duration, float start, float stop, Ease::Enum easing = Ease::Linear);
+	tolua_outside bool Node_stopTween @ stopTween(String name);
+	void stopAllTweens();
+
 	Size alignItemsVertically(float padding = 10.0f);
 	Size alignItemsVertically(Size size, float padding = 10.0f);
 	Size alignItemsHorizontally(float padding = 10.0f);
@@ -547,6 +584,30 @@ class ClipNode : public Node
 	static ClipNode* create(Node* stencil = nullptr);
 };
 
+class Prefab : public Object
+{
+	tolua_readonly tolua_property__common Node* node;
+	tolua_readonly tolua_property__common Uint32 instanceCount;
+	Node* instantiate();
+	static Prefab* create(Node* node);
+};
+
+class NodePool : public Object
+{
+	tolua_property__common Uint32 capacity;
+	tolua_readonly tolua_property__common Uint32 idleCount;
+	tolua_readonly tolua_property__common Uint32 hitCount;
+	tolua_readonly tolua_property__common Uint32 missCount;
+	tolua_readonly tolua_property__common float hitRate;
+	Node* get();
+	void recycle(Node* node);
+	void reserve(Uint32 count);
+	void clear();
+	void resetStats();
+	static NodePool* create(Prefab* prefab);
+	static NodePool* create(tolua_function_Node* factory);
+};
+
 struct VertexColor
 {
 	VertexColor(Vec2 vertex, Color color);
@@ -617,6 +678,7 @@ class Model : public Node
 class PhysicsWorld : public Node
 {
 	tolua_property__bool bool showDebug;
+	tolua_property__bool bool interpolation;
 	bool query(Rect rect, tolua_function_bool handler);
 	bool raycast(Vec2 start, Vec2 stop, bool closest, tolua_function_bool handler);
 	void setIterations(int velocityIter, int positionIter);
@@ -990,6 +1052,7 @@ struct Cache
 	static bool unload(String name);
 	static void removeUnused();
 	static void removeUnused(String type);
+	static void setTextureAtlasEnabled(bool var);
 }
 
 class Audio